@@ -0,0 +1,420 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include "../UnlogImplementation.h"
+#include "../Target/BinaryRingFile.h"
+#include "../Target/Trace.h"
+#include "../Target/JsonFile.h"
+#include "Testing.h"
+#include <Templates/IntegerSequence.h>
+
+// ------------------------------------------------------------------------------------
+// Benchmark
+//
+// Measures the time and heap allocations per call of every logging entry point, of
+// messages rejected at each stage of the pipeline and of each target.
+//
+// Allocations are counted by wrapping GMalloc while a case runs, so it's best to run it
+// when nothing else is allocating (e.g from a commandlet or a dedicated test):
+// UnlogBenchmark::Run( *GLog );
+//
+// RunStress instead logs from several threads at once for a fixed duration, reporting
+// throughput, call latency percentiles and how many messages the async queue dropped:
+// UnlogBenchmark::RunStress( *GLog, 8, 5.0 );
+// ------------------------------------------------------------------------------------
+
+UNLOG_CATEGORY(LogUnlogBenchmark)
+UNLOG_CATEGORY(LogUnlogBenchmarkOther)
+UNLOG_CATEGORY(LogUnlogBenchmarkPushed)
+
+struct UnlogBenchmark
+{
+    struct FResult
+    {
+        FString Name;
+        double NanosecondsPerCall;
+        double AllocationsPerCall;
+    };
+
+    // Runs every case, printing one line per case. Targets writing somewhere (e.g UELog) run Iterations / 100 times
+    static TArray<FResult> Run(FOutputDevice& Ar, int32 Iterations = 100000)
+    {
+        TArray<FResult> Results;
+        const int32 OutputIterations = FMath::Max(1, Iterations / 100);
+
+        LogUnlogBenchmark::Static().SetVerbosity(ELogVerbosity::Log);
+        using Unlog = TUnlog<>::WithCategory<LogUnlogBenchmark>::WithTargets<FDiscard>;
+
+        const int32 Value = 42;
+        const bool bFalse = Iterations < 0; // Not known at compile time, so conditions aren't folded away
+
+        // Entry points, emitted
+        Measure(Ar, Results, TEXT("Emitted Unlog::Log"), Iterations, [&] { Unlog::Log("Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Emitted Unlog::Logf"), Iterations, [&] { Unlog::Logf(TEXT("Value %d"), Value); });
+        Measure(Ar, Results, TEXT("Emitted UNLOG"), Iterations, [&] { UNLOG(Log)("Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Emitted UNLOGF"), Iterations, [&] { UNLOGF(Log)("Value %d", Value); });
+        Measure(Ar, Results, TEXT("Emitted UN_LOG"), Iterations, [&] { UN_LOG(, Log, "Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Emitted UN_LOGF"), Iterations, [&] { UN_LOGF(, Log, "Value %d", Value); });
+        Measure(Ar, Results, TEXT("Emitted Unlog::Log( true, ... )"), Iterations, [&] { Unlog::Log(!bFalse, "Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Emitted UNCLOG"), Iterations, [&] { UNCLOG(!bFalse, Log)("Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Emitted UN_CLOG"), Iterations, [&] { UN_CLOG(!bFalse, , Log, "Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Emitted scoped category"), Iterations, [&]
+        {
+            UNLOG_CATEGORY_SCOPED(LogUnlogBenchmarkScoped);
+            TUnlog<>::WithTargets<FDiscard>::Log("Value {0}", Value);
+        });
+
+        // Entry points, rejected
+        Measure(Ar, Results, TEXT("Runtime verbosity Unlog::Verbose"), Iterations, [&] { Unlog::Verbose("Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Runtime verbosity Unlog::Verbosef"), Iterations, [&] { Unlog::Verbosef(TEXT("Value %d"), Value); });
+        Measure(Ar, Results, TEXT("Runtime verbosity UNLOG"), Iterations, [&] { UNLOG(Verbose)("Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Runtime verbosity UNLOGF"), Iterations, [&] { UNLOGF(Verbose)("Value %d", Value); });
+        Measure(Ar, Results, TEXT("Runtime verbosity UN_LOG"), Iterations, [&] { UN_LOG(, Verbose, "Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Condition Unlog::Log( false, ... )"), Iterations, [&] { Unlog::Log(bFalse, "Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Condition UNCLOG"), Iterations, [&] { UNCLOG(bFalse, Log)("Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Condition UN_CLOG"), Iterations, [&] { UN_CLOG(bFalse, , Log, "Value {0}", Value); });
+
+        using QuietUnlog = Unlog::WithCompileTimeVerbosity<ELogVerbosity::Warning>;
+        Measure(Ar, Results, TEXT("Compile-time verbosity Unlog::Log"), Iterations, [&] { QuietUnlog::Log("Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Compile-time verbosity UNLOG"), Iterations, [&] { UNLOG(QuietUnlog, Log)("Value {0}", Value); });
+
+        FUnlogCallSiteQuery SwitchedOff;
+        SwitchedOff.Format = TEXT("Switched off*");
+        FUnlogCallSite::SetEnabled(SwitchedOff, false);
+        Measure(Ar, Results, TEXT("Call site switched off UNLOG"), Iterations, [&] { UNLOG(Log)("Switched off {0}", Value); });
+        FUnlogCallSite::SetEnabled(SwitchedOff, true);
+
+        Measure(Ar, Results, TEXT("Rate limited WithRateLimit< 1 >"), Iterations, [&] { Unlog::WithRateLimit<1>::Log("Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Sampled WithSampling< 100 >"), Iterations, [&] { Unlog::WithSampling<100>::Log("Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Sampled WithSampling< 100, Random >"), Iterations, [&] { Unlog::WithSampling<100, EUnlogSampling::Random>::Log("Value {0}", Value); });
+
+        // Argument count and types
+        MeasureArguments(Ar, Results, TEXT("int32"), Iterations, Value);
+        MeasureArguments(Ar, Results, TEXT("double"), Iterations, 3.14159);
+        MeasureArguments(Ar, Results, TEXT("const TCHAR*"), Iterations, TEXT("Literal"));
+        MeasureArguments(Ar, Results, TEXT("FString"), Iterations, FString(TEXT("String")));
+        MeasureArguments(Ar, Results, TEXT("FName"), Iterations, FName(TEXT("Name")));
+        MeasureArguments(Ar, Results, TEXT("FText"), Iterations, FText::FromString(TEXT("Text")));
+        Measure(Ar, Results, TEXT("Field int32"), Iterations, [&] { Unlog::Log("Value", UNLOG_FIELD(Value)); });
+
+        // Targets
+        Measure(Ar, Results, TEXT("Target UELog"), OutputIterations, [&] { Unlog::WithTargets<Target::UELog>::Log("Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Target BinaryRingFile"), Iterations, [&] { Unlog::WithTargets<Target::BinaryRingFile>::Log("Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Target JsonFile, 1 field"), OutputIterations, [&] { Unlog::WithTargets<Target::JsonFile>::Log("Value", UNLOG_FIELD(Value)); });
+        Unlog::Flush();
+#if UE_TRACE_ENABLED
+        // Compared with the channel on, the cost of encoding the arguments instead of formatting them
+        const FString String(TEXT("String"));
+        const bool bWasTracing = FUnlogTrace::IsEnabled();
+        UE::Trace::ToggleChannel(TEXT("Unlog"), true);
+        Measure(Ar, Results, TEXT("Target Trace"), Iterations, [&] { Unlog::WithTargets<Target::Trace>::Log("Value {0}", Value); });
+        Measure(Ar, Results, TEXT("Target Trace, 4 FString"), Iterations, [&] { Unlog::WithTargets<Target::Trace>::Log("Value {0} {1} {2} {3}", String, String, String, String); });
+        UE::Trace::ToggleChannel(TEXT("Unlog"), bWasTracing);
+#endif
+        if (GEngine)
+        {
+            Measure(Ar, Results, TEXT("Target Viewport"), OutputIterations, [&] { Unlog::WithTargets<Target::Viewport>::Log("Value {0}", Value); });
+            Measure(Ar, Results, TEXT("Target KeyedViewport"), OutputIterations, [&] { Unlog::WithTargets<Target::KeyedViewport>::Log("Value {0}", Value); });
+        }
+        Measure(Ar, Results, TEXT("Target TAsync< Discard, Drop >"), Iterations, [&] { Unlog::WithAsync<EUnlogAsyncPolicy::Drop>::Log("Value {0}", Value); });
+        Unlog::Flush();
+        Measure(Ar, Results, TEXT("Target TDeduplicate< Discard > repeats"), Iterations, [&] { Unlog::WithDeduplication<>::Log("Value {0}", Value); });
+        Unlog::Flush();
+
+        return Results;
+    }
+
+    struct FStressResult
+    {
+        int32 NumThreads;
+        double Seconds;
+        uint64 NumCalls;
+        double CallsPerSecond;
+        double P50Nanoseconds;
+        double P99Nanoseconds;
+        double P999Nanoseconds;
+        double MaxNanoseconds;
+        uint64 NumDropped;
+    };
+
+    /**
+    * Every thread cycles through the same mix of calls: two categories, a scoped category, a call rejected by
+    * verbosity, printf, the macros, an async queue small enough to overflow and the ring file.
+    * Latencies include reading the clock around each call and are bucketed with a 12.5% resolution.
+    */
+    static FStressResult RunStress(FOutputDevice& Ar, int32 NumThreads = 8, double DurationSeconds = 5.0)
+    {
+        LogUnlogBenchmark::Static().SetVerbosity(ELogVerbosity::Log);
+        using AsyncUnlog = TUnlog<>::WithCategory<LogUnlogBenchmark>::WithTargets<FDiscard>::WithAsync<EUnlogAsyncPolicy::Drop, 1024>;
+        const uint64 StartDropped = AsyncUnlog::TargetOptions::GetNumDropped();
+
+        std::atomic<bool> bStart(false);
+        TArray<FStressProducer*> Producers;
+        TArray<FRunnableThread*> Threads;
+        for (int32 Index = 0; Index < NumThreads; ++Index)
+        {
+            Producers.Add(new FStressProducer(bStart));
+            Threads.Add(FRunnableThread::Create(Producers.Last(), *FString::Printf(TEXT("UnlogStress%d"), Index)));
+        }
+
+        // Producers spin until every thread exists, then share the same deadline
+        const double StartSeconds = FPlatformTime::Seconds();
+        for (FStressProducer* Producer : Producers)
+        {
+            Producer->EndSeconds = StartSeconds + DurationSeconds;
+        }
+        bStart.store(true, std::memory_order_release);
+
+        FLatencyHistogram Latencies;
+        uint64 NumCalls = 0;
+        for (int32 Index = 0; Index < NumThreads; ++Index)
+        {
+            Threads[Index]->WaitForCompletion();
+            delete Threads[Index];
+
+            Latencies.Merge(Producers[Index]->Latencies);
+            NumCalls += Producers[Index]->NumCalls;
+            delete Producers[Index];
+        }
+        const double Seconds = FPlatformTime::Seconds() - StartSeconds;
+        TUnlog<>::Flush();
+
+        FStressResult Result;
+        Result.NumThreads = NumThreads;
+        Result.Seconds = Seconds;
+        Result.NumCalls = NumCalls;
+        Result.CallsPerSecond = NumCalls / Seconds;
+        Result.P50Nanoseconds = Latencies.GetPercentile(0.5) * FPlatformTime::GetSecondsPerCycle64() * 1e9;
+        Result.P99Nanoseconds = Latencies.GetPercentile(0.99) * FPlatformTime::GetSecondsPerCycle64() * 1e9;
+        Result.P999Nanoseconds = Latencies.GetPercentile(0.999) * FPlatformTime::GetSecondsPerCycle64() * 1e9;
+        Result.MaxNanoseconds = Latencies.GetMax() * FPlatformTime::GetSecondsPerCycle64() * 1e9;
+        Result.NumDropped = AsyncUnlog::TargetOptions::GetNumDropped() - StartDropped;
+
+        Ar.Logf(TEXT("%d threads for %.2fs: %llu calls, %.0f calls/sec"), NumThreads, Seconds, (unsigned long long)NumCalls, Result.CallsPerSecond);
+        Ar.Logf(TEXT("Latency p50 %.0f ns, p99 %.0f ns, p99.9 %.0f ns, max %.0f ns"), Result.P50Nanoseconds, Result.P99Nanoseconds, Result.P999Nanoseconds, Result.MaxNanoseconds);
+        Ar.Logf(TEXT("Async queue dropped %llu messages"), (unsigned long long)Result.NumDropped);
+        return Result;
+    }
+
+private:
+    // Keeps the messages alive as far as the compiler knows
+    struct FDiscard
+    {
+        static void Call(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            GetNumCharacters().fetch_add(Message.Len(), std::memory_order_relaxed);
+        }
+
+        static std::atomic<uint64>& GetNumCharacters()
+        {
+            static std::atomic<uint64> NumCharacters(0);
+            return NumCharacters;
+        }
+    };
+
+    template< typename FunctionType >
+    static void Measure(FOutputDevice& Ar, TArray<FResult>& Results, const FString& Name, int32 Iterations, const FunctionType& Function)
+    {
+        // Warm up, first calls register call sites, parse formats and create loggers
+        for (int32 Index = 0; Index < 100; ++Index)
+        {
+            Function();
+        }
+
+        uint64 NumAllocations = 0;
+        uint64 StartCycles = 0;
+        uint64 EndCycles = 0;
+        {
+            FUnlogAllocationCounter AllocationCounter;
+
+            StartCycles = FPlatformTime::Cycles64();
+            for (int32 Index = 0; Index < Iterations; ++Index)
+            {
+                Function();
+            }
+            EndCycles = FPlatformTime::Cycles64();
+
+            NumAllocations = AllocationCounter.GetNumAllocations();
+        }
+
+        FResult Result;
+        Result.Name = Name;
+        Result.NanosecondsPerCall = (double)(EndCycles - StartCycles) * FPlatformTime::GetSecondsPerCycle64() * 1e9 / Iterations;
+        Result.AllocationsPerCall = (double)NumAllocations / Iterations;
+
+        Ar.Logf(TEXT("%-48s %10.1f ns/call %8.3f allocs/call"), *Result.Name, Result.NanosecondsPerCall, Result.AllocationsPerCall);
+        Results.Add(Result);
+    }
+
+    // Log-linear buckets in cycles, 8 per power of two
+    struct FLatencyHistogram
+    {
+        static constexpr int32 NumLinearBuckets = 16;
+        static constexpr int32 NumBuckets = NumLinearBuckets + (64 - 4) * 8;
+
+        uint64 Counts[NumBuckets] = {};
+        uint64 NumSamples = 0;
+        uint64 Max = 0;
+
+        void Add(uint64 Cycles)
+        {
+            ++Counts[GetBucket(Cycles)];
+            ++NumSamples;
+            Max = FMath::Max(Max, Cycles);
+        }
+
+        void Merge(const FLatencyHistogram& Other)
+        {
+            for (int32 Index = 0; Index < NumBuckets; ++Index)
+            {
+                Counts[Index] += Other.Counts[Index];
+            }
+            NumSamples += Other.NumSamples;
+            Max = FMath::Max(Max, Other.Max);
+        }
+
+        // Lower bound of the bucket holding the percentile
+        uint64 GetPercentile(double Percentile) const
+        {
+            const uint64 Target = (uint64)(Percentile * NumSamples);
+            uint64 Seen = 0;
+            for (int32 Index = 0; Index < NumBuckets; ++Index)
+            {
+                Seen += Counts[Index];
+                if (Seen > Target)
+                {
+                    return GetBucketMin(Index);
+                }
+            }
+            return Max;
+        }
+
+        uint64 GetMax() const
+        {
+            return Max;
+        }
+
+        static int32 GetBucket(uint64 Cycles)
+        {
+            if (Cycles < NumLinearBuckets)
+            {
+                return (int32)Cycles;
+            }
+            const uint32 Log2 = (uint32)FMath::FloorLog2_64(Cycles);
+            return NumLinearBuckets + (Log2 - 4) * 8 + (int32)((Cycles >> (Log2 - 3)) & 7);
+        }
+
+        static uint64 GetBucketMin(int32 Bucket)
+        {
+            if (Bucket < NumLinearBuckets)
+            {
+                return Bucket;
+            }
+            const uint32 Log2 = 4 + (Bucket - NumLinearBuckets) / 8;
+            return (uint64)(8 + (Bucket - NumLinearBuckets) % 8) << (Log2 - 3);
+        }
+    };
+
+    class FStressProducer : public FRunnable
+    {
+    public:
+        explicit FStressProducer(const std::atomic<bool>& bInStart)
+            : bStart(bInStart)
+        {}
+
+        virtual uint32 Run() override
+        {
+            using Unlog = TUnlog<>::WithCategory<LogUnlogBenchmark>::WithTargets<FDiscard>;
+            using OtherUnlog = TUnlog<>::WithCategory<LogUnlogBenchmarkOther>::WithTargets<FDiscard>;
+            using ScopedUnlog = TUnlog<>::WithTargets<FDiscard>;
+            using AsyncUnlog = Unlog::WithAsync<EUnlogAsyncPolicy::Drop, 1024>;
+            using RingFileUnlog = Unlog::WithTargets<Target::BinaryRingFile>;
+
+            while (!bStart.load(std::memory_order_acquire))
+            {
+                FPlatformProcess::Yield();
+            }
+
+            const FString String(TEXT("String"));
+            const FName Name(TEXT("Name"));
+            const FText Text = FText::FromString(String);
+
+            for (int32 Index = 0; ; ++Index)
+            {
+                if ((Index & 255) == 0 && FPlatformTime::Seconds() >= EndSeconds)
+                {
+                    return 0;
+                }
+
+                const uint64 StartCycles = FPlatformTime::Cycles64();
+                switch (Index & 7)
+                {
+                case 0:
+                    Unlog::Log("Stress {0}", Index);
+                    break;
+                case 1:
+                    OtherUnlog::Warn("Stress {0} {1} {2}", String, 3.14159, Name);
+                    break;
+                case 2:
+                {
+                    UNLOG_CATEGORY_PUSH(LogUnlogBenchmarkPushed)
+                    ScopedUnlog::Log("Scoped {0}", Text);
+                    break;
+                }
+                case 3:
+                    Unlog::Verbose("Rejected {0}", Index);
+                    break;
+                case 4:
+                    Unlog::Logf(TEXT("Printf %d %s"), Index, *String);
+                    break;
+                case 5:
+                    UNLOG(OtherUnlog, Log)("Macro {0} {1}", Index, Name);
+                    break;
+                case 6:
+                    AsyncUnlog::Log("Async {0}", Index);
+                    break;
+                case 7:
+                    RingFileUnlog::Log("Ring file {0}", Index);
+                    break;
+                }
+                Latencies.Add(FPlatformTime::Cycles64() - StartCycles);
+                ++NumCalls;
+            }
+        }
+
+        const std::atomic<bool>& bStart;
+        double EndSeconds = 0.0;
+        FLatencyHistogram Latencies;
+        uint64 NumCalls = 0;
+    };
+
+    // Literal formats, so calls take the same path as hand written ones
+    static const auto& GetFormat(TMakeIntegerSequence<uint32, 0>) { return "No arguments"; }
+    static const auto& GetFormat(TMakeIntegerSequence<uint32, 1>) { return "{0}"; }
+    static const auto& GetFormat(TMakeIntegerSequence<uint32, 2>) { return "{0} {1}"; }
+    static const auto& GetFormat(TMakeIntegerSequence<uint32, 4>) { return "{0} {1} {2} {3}"; }
+    static const auto& GetFormat(TMakeIntegerSequence<uint32, 8>) { return "{0} {1} {2} {3} {4} {5} {6} {7}"; }
+
+    // The same argument repeated once per index
+    template< typename ArgType, uint32... ArgIndices >
+    static void MeasureArgumentCount(FOutputDevice& Ar, TArray<FResult>& Results, const TCHAR* TypeName, int32 Iterations, const ArgType& Arg, TIntegerSequence<uint32, ArgIndices...> Indices)
+    {
+        using Unlog = TUnlog<>::WithCategory<LogUnlogBenchmark>::WithTargets<FDiscard>;
+        const auto& Format = GetFormat(Indices);
+
+        Measure(Ar, Results, FString::Printf(TEXT("Arguments %u x %s"), (uint32)sizeof...(ArgIndices), TypeName), Iterations, [&]
+        {
+            Unlog::Log(Format, ((void)ArgIndices, Arg)...);
+        });
+    }
+
+    template< typename ArgType >
+    static void MeasureArguments(FOutputDevice& Ar, TArray<FResult>& Results, const TCHAR* TypeName, int32 Iterations, const ArgType& Arg)
+    {
+        MeasureArgumentCount(Ar, Results, TypeName, Iterations, Arg, TMakeIntegerSequence<uint32, 0>());
+        MeasureArgumentCount(Ar, Results, TypeName, Iterations, Arg, TMakeIntegerSequence<uint32, 1>());
+        MeasureArgumentCount(Ar, Results, TypeName, Iterations, Arg, TMakeIntegerSequence<uint32, 2>());
+        MeasureArgumentCount(Ar, Results, TypeName, Iterations, Arg, TMakeIntegerSequence<uint32, 4>());
+        MeasureArgumentCount(Ar, Results, TypeName, Iterations, Arg, TMakeIntegerSequence<uint32, 8>());
+    }
+};
@@ -2,10 +2,193 @@
 #pragma once
 
 #include "../UnlogImplementation.h"
+#include "../Target/Trace.h"
+#include "../Target/JsonFile.h"
+#include <HAL/MemoryBase.h>
 // ------------------------------------------------------------------------------------
 // Testing
+//
+// CompileTest only checks the API compiles. RunTests logs through Target::Capture and
+// checks the routed category, verbosity and text, along with allocation and latency
+// budgets for the hot paths. Returns the number of failed checks, e.g from a commandlet:
+// UnlogTesting::RunTests( *GLog );
 // ------------------------------------------------------------------------------------
 
+/**
+* Counts the allocations going through GMalloc while in scope, forwarding everything to the allocator it replaces.
+* Counts allocations from every thread, so nothing else should be allocating meanwhile.
+*/
+class FUnlogAllocationCounter : public FMalloc
+{
+public:
+    FUnlogAllocationCounter()
+        : Inner(GMalloc)
+        , NumAllocations(0)
+    {
+        GMalloc = this;
+    }
+
+    virtual ~FUnlogAllocationCounter()
+    {
+        GMalloc = Inner;
+    }
+
+    virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+    {
+        NumAllocations.fetch_add(1, std::memory_order_relaxed);
+        return Inner->Malloc(Count, Alignment);
+    }
+
+    virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+    {
+        NumAllocations.fetch_add(Count > 0 ? 1 : 0, std::memory_order_relaxed);
+        return Inner->Realloc(Original, Count, Alignment);
+    }
+
+    virtual void Free(void* Original) override
+    {
+        Inner->Free(Original);
+    }
+
+    virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+    {
+        return Inner->QuantizeSize(Count, Alignment);
+    }
+
+    virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+    {
+        return Inner->GetAllocationSize(Original, SizeOut);
+    }
+
+    virtual bool IsInternallyThreadSafe() const override
+    {
+        return Inner->IsInternallyThreadSafe();
+    }
+
+    virtual const TCHAR* GetDescriptiveName() override
+    {
+        return TEXT("UnlogAllocationCounter");
+    }
+
+    uint64 GetNumAllocations() const
+    {
+        return NumAllocations.load(std::memory_order_relaxed);
+    }
+
+private:
+    FMalloc* Inner;
+    std::atomic<uint64> NumAllocations;
+};
+
+struct FUnlogCapturedMessage
+{
+    FName Category;
+    ELogVerbosity::Type Verbosity;
+    FString Message;
+    const FUnlogCallSite* CallSite;
+};
+
+struct FUnlogCapturedArgs
+{
+    // Whether the message reached the target already formatted
+    bool bWasFormatted;
+    int32 NumArgs;
+    TArray<uint8> Encoded;
+    FString Rendered;
+    FString RenderedWithoutFields;
+    const FUnlogCallSite* CallSite;
+};
+
+namespace Target
+{
+    // Keeps every message in memory so tests can inspect them
+    struct Capture
+    {
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            FScopeLock Lock(&GetLock());
+            GetMessages().Add(FUnlogCapturedMessage{ Category.GetName(), Verbosity, FString(Message.Len(), Message.GetData()), Source.CallSite });
+        }
+
+        // Slack is reserved so capturing up to that many messages doesn't grow the array
+        static void Reset(int32 Slack = 0)
+        {
+            FScopeLock Lock(&GetLock());
+            GetMessages().Reset(Slack);
+        }
+
+        static TArray<FUnlogCapturedMessage>& GetMessages()
+        {
+            static TArray<FUnlogCapturedMessage> Messages;
+            return Messages;
+        }
+
+    private:
+        static FCriticalSection& GetLock()
+        {
+            static FCriticalSection Lock;
+            return Lock;
+        }
+    };
+}
+
+namespace Target
+{
+    // Takes messages unformatted and keeps their encoded arguments, like machine-readable targets do
+    struct CaptureArgs
+    {
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FUnlogMessageArgs& Args)
+        {
+            FUnlogCapturedArgs Captured{ Args.IsFormatted(), Args.NumArgs, TArray<uint8>(), FString(), FString(), Source.CallSite };
+
+            uint8 Encoded[256];
+            const int32 NumEncoded = Args.Encode(Encoded, sizeof(Encoded));
+            for (int32 Index = 0; Index < NumEncoded; ++Index)
+            {
+                Captured.Encoded.Add(Encoded[Index]);
+            }
+
+            TStringBuilder<256> Rendered;
+            Args.Render(Rendered);
+            Captured.Rendered = FString(Rendered.Len(), Rendered.ToString());
+
+            Rendered.Reset();
+            Args.RenderWithoutFields(Rendered);
+            Captured.RenderedWithoutFields = FString(Rendered.Len(), Rendered.ToString());
+
+            FScopeLock Lock(&GetLock());
+            GetArgs().Add(Captured);
+        }
+
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            FScopeLock Lock(&GetLock());
+            GetArgs().Add(FUnlogCapturedArgs{ true, 0, TArray<uint8>(), FString(Message.Len(), Message.GetData()), FString(Message.Len(), Message.GetData()), Source.CallSite });
+        }
+
+        static void Reset()
+        {
+            FScopeLock Lock(&GetLock());
+            GetArgs().Reset();
+        }
+
+        static TArray<FUnlogCapturedArgs>& GetArgs()
+        {
+            static TArray<FUnlogCapturedArgs> Args;
+            return Args;
+        }
+
+    private:
+        static FCriticalSection& GetLock()
+        {
+            static FCriticalSection Lock;
+            return Lock;
+        }
+    };
+}
+
+#define UNLOG_TEST_CHECK( Expression ) Context.Check( (Expression), TEXT( #Expression ), __LINE__ )
+
 struct UnlogTesting
 {
     // Simple test to ensure everything compiles correctly; outputs are not tested
@@ -30,6 +213,11 @@ struct UnlogTesting
         Unlog::Error<TestCategory>("C");
         Unlog::Verbose<TestCategory>("D");
 
+        // Runtime verbosity
+        TestCategory::Static().SetVerbosity(ELogVerbosity::Verbose);
+        Unlog::Verbose<TestCategory>("D");
+        TestCategory::Static().SetVerbosity(ELogVerbosity::Log);
+
         // Derive category
         UN_LOG(, Log, "A");
         Unlog::Log("A");
@@ -41,6 +229,12 @@ struct UnlogTesting
         UNLOG(Log)("{0}: {1}", ExampleString, ExampleInt);
         UN_LOG(, Log, "{0}: {1}", ExampleString, ExampleInt);
 
+        // Format - arguments are read in place, including temporaries and text types
+        const FText ExampleText = FText::FromString(ExampleString);
+        const FName ExampleName(TEXT("Name"));
+        Unlog::Log("{0} {1} {2}", ExampleText, ExampleName, FString(TEXT("Temporary")));
+        UNLOG(Log)("{0} {1}", ExampleText, ExampleName);
+
         // Format - printf
         Unlog::Logf(TEXT("%s: %d"), *ExampleString, ExampleInt);
         UNLOGF(Log)("%s: %d", *ExampleString, ExampleInt);
@@ -52,6 +246,62 @@ struct UnlogTesting
         UNLOG(CustomUnlog, Error)("X");
         UN_LOG(CustomUnlog, Error, "X");
 
+        // Unreal Insights, messages only going to targets taking the arguments are never formatted
+        using InsightsUnlog = TUnlog<>::WithTargets< Target::Trace >;
+        InsightsUnlog::Log("{0}: {1}", ExampleString, ExampleInt);
+        UNLOG(InsightsUnlog, Log)("{0}: {1}", ExampleString, ExampleInt);
+        TUnlog<>::AddTarget< Target::Trace >::Log("{0}: {1}", ExampleString, ExampleInt);
+
+        // Fields, appended to the text as Name=Value and kept typed by targets like Target::JsonFile
+        Unlog::Log("Spawned", UNLOG_FIELD(ExampleString), UNLOG_FIELD(ExampleInt));
+        UNLOG(Log)("Spawned {0}", ExampleText, UNLOG_NAMED_FIELD(Health, ExampleInt * 2));
+        TUnlog<>::AddTarget< Target::JsonFile >::Log("Spawned", UNLOG_FIELD(ExampleString));
+
+        // Keyed viewport, repeated calls update the same line
+        using KeyedUnlog = TUnlog<>::WithTargets< Target::KeyedViewport, Target::UELog >;
+        KeyedUnlog::Log("Tick {0}", ExampleInt);
+        UNLOG(KeyedUnlog, Log)("Tick {0}", ExampleInt);
+
+        // Compile-time verbosity, Log and more verbose calls are compiled out
+        using QuietUnlog = TUnlog<>::WithCompileTimeVerbosity< ELogVerbosity::Warning >;
+        QuietUnlog::Log("Compiled out {0}", ExampleInt);
+        QuietUnlog::Warn("Kept {0}", ExampleInt);
+        UNLOG(QuietUnlog, Verbose)("Compiled out {0}", ExampleInt);
+        UN_LOG(QuietUnlog, Error, "Kept {0}", ExampleInt);
+
+        // Rate limited logger, each call site logs at most 10 times per second
+        using LimitedUnlog = TUnlog<>::WithRateLimit< 10 >;
+        LimitedUnlog::Warn("Storm {0}", ExampleInt);
+        UNLOG(LimitedUnlog, Warning)("Storm {0}", ExampleInt);
+        UN_LOG(LimitedUnlog, Warning, "Storm {0}", ExampleInt);
+
+        // Sampled loggers, only 1 in 100 calls is logged
+        using SampledUnlog = TUnlog<>::WithSampling< 100 >;
+        SampledUnlog::Verbose("Sample {0}", ExampleInt);
+        UNLOG(SampledUnlog, Log)("Sample {0}", ExampleInt);
+        TUnlog<>::WithSampling< 100, EUnlogSampling::Random >::Log("Sample {0}", ExampleInt);
+
+        // Deduplicated logger, consecutive repeats are collapsed
+        using DedupUnlog = TUnlog<>::WithTargets< Target::UELog, Target::Viewport >::WithDeduplication<>;
+        DedupUnlog::Warn("Failed to find socket {0}", ExampleString);
+        DedupUnlog::Warn("Failed to find socket {0}", ExampleString);
+        UNLOG(DedupUnlog, Warning)("Failed to find socket {0}", ExampleString);
+
+        // Using an async logger
+        using AsyncUnlog = TUnlog<>::WithTargets< Target::UELog >::WithAsync< EUnlogAsyncPolicy::Drop >;
+        AsyncUnlog::Log("{0}: {1}", ExampleString, ExampleInt);
+        UNLOG(AsyncUnlog, Log)("{0}: {1}", ExampleString, ExampleInt);
+        Unlog::Flush();
+
+        // Call sites hit so far, switching some off at runtime
+        FUnlogCallSite::ForEach([](FUnlogCallSite& CallSite) {});
+
+        FUnlogCallSiteQuery Query;
+        Query.Format = TEXT("Switched*");
+        FUnlogCallSite::SetEnabled(Query, false);
+        UNLOG(Log)("Switched off {0}", ExampleInt);
+        FUnlogCallSite::ResetEnabled();
+
         // Contional logging
         const bool Value = false;
         Unlog::Warn(Value, "Y");
@@ -70,4 +320,538 @@ struct UnlogTesting
             UNLOG(Log)("Test Scoped Category");
         }
     }
+
+    // Average budgets per call, generous enough for unoptimized and sanitized builds
+    static constexpr double FilteredCallBudgetNanoseconds = 1000.0;
+    static constexpr double EmittedCallBudgetNanoseconds = 50000.0;
+
+    // The captured copy of the message is the only allocation an emitted message is allowed
+    static constexpr uint64 EmittedCallAllocationBudget = 1;
+
+    struct FTestContext
+    {
+        FOutputDevice& Ar;
+        int32 NumFailures;
+
+        bool Check(bool bPassed, const TCHAR* Expression, int32 Line)
+        {
+            if (!bPassed)
+            {
+                Ar.Logf(TEXT("Unlog test failed at line %d: %s"), Line, Expression);
+                ++NumFailures;
+            }
+            return bPassed;
+        }
+    };
+
+    // Runs every test, returning how many checks failed
+    static int32 RunTests(FOutputDevice& Ar)
+    {
+        FTestContext Context{ Ar, 0 };
+#if UNLOG_ENABLED
+        TestRouting(Context);
+        TestVerbosity(Context);
+        TestText(Context);
+        TestConditions(Context);
+        TestFilters(Context);
+        TestMessageArgs(Context);
+        TestFields(Context);
+        TestAllocations(Context);
+        TestLatency(Context);
+        TestCategoryStats(Context);
+#else
+        TestCompiledOut(Context);
+#endif
+        Target::Capture::Reset();
+        Target::CaptureArgs::Reset();
+
+        Ar.Logf(TEXT("Unlog tests finished with %d failed checks"), Context.NumFailures);
+        return Context.NumFailures;
+    }
+
+private:
+    static bool IsCaptured(int32 Index, const TCHAR* Category, ELogVerbosity::Type Verbosity, const TCHAR* Message)
+    {
+        const TArray<FUnlogCapturedMessage>& Messages = Target::Capture::GetMessages();
+        return Messages.IsValidIndex(Index)
+            && Messages[Index].Category == FName(Category)
+            && Messages[Index].Verbosity == Verbosity
+            && Messages[Index].Message == Message;
+    }
+
+    static int32 NumCaptured()
+    {
+        return Target::Capture::GetMessages().Num();
+    }
+
+#if UNLOG_ENABLED
+    static void TestRouting(FTestContext& Context)
+    {
+        using Unlog = TUnlog<>::WithTargets<Target::Capture>;
+        UNLOG_CATEGORY(LogUnlogTestRouting)
+        Target::Capture::Reset();
+
+        Unlog::Log<LogUnlogTestRouting>("Explicit");
+        Unlog::Log("Default");
+        Unlog::WithCategory<LogUnlogTestRouting>::Log("Logger category");
+        UNLOG(LogUnlogTestRouting, Log)("Macro category");
+        UN_LOG(, Log, "Macro default");
+        {
+            UNLOG_CATEGORY_SCOPED(LogUnlogTestScoped);
+            Unlog::Log("Scoped");
+            {
+                UNLOG_CATEGORY_SCOPED(LogUnlogTestNested);
+                UNLOG(Log)("Nested");
+            }
+            Unlog::Log("Scoped again");
+            Unlog::Log<LogUnlogTestRouting>("Explicit wins over scoped");
+        }
+        Unlog::Log("Default again");
+
+        UNLOG_TEST_CHECK(NumCaptured() == 10);
+        UNLOG_TEST_CHECK(IsCaptured(0, TEXT("LogUnlogTestRouting"), ELogVerbosity::Log, TEXT("Explicit")));
+        UNLOG_TEST_CHECK(IsCaptured(1, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Default")));
+        UNLOG_TEST_CHECK(IsCaptured(2, TEXT("LogUnlogTestRouting"), ELogVerbosity::Log, TEXT("Logger category")));
+        UNLOG_TEST_CHECK(IsCaptured(3, TEXT("LogUnlogTestRouting"), ELogVerbosity::Log, TEXT("Macro category")));
+        UNLOG_TEST_CHECK(IsCaptured(4, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Macro default")));
+        UNLOG_TEST_CHECK(IsCaptured(5, TEXT("LogUnlogTestScoped"), ELogVerbosity::Log, TEXT("Scoped")));
+        UNLOG_TEST_CHECK(IsCaptured(6, TEXT("LogUnlogTestNested"), ELogVerbosity::Log, TEXT("Nested")));
+        UNLOG_TEST_CHECK(IsCaptured(7, TEXT("LogUnlogTestScoped"), ELogVerbosity::Log, TEXT("Scoped again")));
+        UNLOG_TEST_CHECK(IsCaptured(8, TEXT("LogUnlogTestRouting"), ELogVerbosity::Log, TEXT("Explicit wins over scoped")));
+        UNLOG_TEST_CHECK(IsCaptured(9, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Default again")));
+
+        // Macros describe their own call site, the functions have none
+        const TArray<FUnlogCapturedMessage>& Messages = Target::Capture::GetMessages();
+        UNLOG_TEST_CHECK(Messages[3].CallSite && Messages[3].CallSite->Line > 0);
+        UNLOG_TEST_CHECK(Messages[0].CallSite == nullptr);
+    }
+
+    static void TestVerbosity(FTestContext& Context)
+    {
+        using Unlog = TUnlog<>::WithTargets<Target::Capture>;
+        UNLOG_CATEGORY(LogUnlogTestVerbosity)
+        Target::Capture::Reset();
+
+        Unlog::Error<LogUnlogTestVerbosity>("Error");
+        Unlog::Warn<LogUnlogTestVerbosity>("Warning");
+        Unlog::Log<LogUnlogTestVerbosity>("Log");
+        Unlog::Verbose<LogUnlogTestVerbosity>("Rejected verbose");
+        UNLOG(LogUnlogTestVerbosity, VeryVerbose)("Rejected very verbose");
+
+        LogUnlogTestVerbosity::Static().SetVerbosity(ELogVerbosity::Verbose);
+        Unlog::Verbose<LogUnlogTestVerbosity>("Verbose");
+
+        LogUnlogTestVerbosity::Static().SetVerbosity(ELogVerbosity::Error);
+        Unlog::Warn<LogUnlogTestVerbosity>("Rejected warning");
+        LogUnlogTestVerbosity::Static().SetVerbosity(ELogVerbosity::Log);
+
+        using QuietUnlog = Unlog::WithCompileTimeVerbosity<ELogVerbosity::Warning>;
+        QuietUnlog::Log<LogUnlogTestVerbosity>("Compiled out");
+        QuietUnlog::Warn<LogUnlogTestVerbosity>("Kept");
+
+        UNLOG_TEST_CHECK(NumCaptured() == 5);
+        UNLOG_TEST_CHECK(IsCaptured(0, TEXT("LogUnlogTestVerbosity"), ELogVerbosity::Error, TEXT("Error")));
+        UNLOG_TEST_CHECK(IsCaptured(1, TEXT("LogUnlogTestVerbosity"), ELogVerbosity::Warning, TEXT("Warning")));
+        UNLOG_TEST_CHECK(IsCaptured(2, TEXT("LogUnlogTestVerbosity"), ELogVerbosity::Log, TEXT("Log")));
+        UNLOG_TEST_CHECK(IsCaptured(3, TEXT("LogUnlogTestVerbosity"), ELogVerbosity::Verbose, TEXT("Verbose")));
+        UNLOG_TEST_CHECK(IsCaptured(4, TEXT("LogUnlogTestVerbosity"), ELogVerbosity::Warning, TEXT("Kept")));
+    }
+
+    static void TestText(FTestContext& Context)
+    {
+        using Unlog = TUnlog<>::WithTargets<Target::Capture>;
+        Target::Capture::Reset();
+
+        const FString String(TEXT("String"));
+        const FName Name(TEXT("Name"));
+        const FText Text = FText::FromString(TEXT("Text"));
+        const int32 Int = -42;
+        const uint64 Large = 18446744073709551615ull;
+
+        Unlog::Log("{0} {1} {2} {3} {4}", String, Text, Name, Int, Large);
+        UNLOG(Log)("{1} before {0}, {0} again", String, Name);
+        Unlog::Log("Missing {0} {1}", String);
+        Unlog::Log("Not tokens {} {a} {0", String);
+        Unlog::Logf(TEXT("%s=%d"), *String, Int);
+        UNLOGF(Log)("%s=%d", *String, Int);
+        Unlog::Log("\xe1\x9a\xbb\xe1\x9b\x96 {0}", TEXT("Literal"));
+
+        // Buffers are read up to their terminator, following their contents between calls even when the length is the same
+        TCHAR Buffer[32] = TEXT("First {0}");
+        Unlog::Log(Buffer, String);
+        FMemory::Memcpy(Buffer, TEXT("Second {0}"), sizeof(TEXT("Second {0}")));
+        Unlog::Log(Buffer, String);
+        FMemory::Memcpy(Buffer, TEXT("Third {0}"), sizeof(TEXT("Third {0}")));
+        Unlog::Log(Buffer, String);
+
+        ANSICHAR AnsiBuffer[32] = "First {0}";
+        Unlog::Log(AnsiBuffer, Int);
+        FMemory::Memcpy(AnsiBuffer, "Third {0}", sizeof("Third {0}"));
+        Unlog::Log(AnsiBuffer, Int);
+
+        UNLOG_TEST_CHECK(NumCaptured() == 12);
+        UNLOG_TEST_CHECK(IsCaptured(0, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("String Text Name -42 18446744073709551615")));
+        UNLOG_TEST_CHECK(IsCaptured(1, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Name before String, String again")));
+        UNLOG_TEST_CHECK(IsCaptured(2, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Missing String {1}")));
+        UNLOG_TEST_CHECK(IsCaptured(3, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Not tokens {} {a} {0")));
+        UNLOG_TEST_CHECK(IsCaptured(4, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("String=-42")));
+        UNLOG_TEST_CHECK(IsCaptured(5, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("String=-42")));
+        UNLOG_TEST_CHECK(IsCaptured(6, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("\x16BB\x16D6 Literal")));
+        UNLOG_TEST_CHECK(IsCaptured(7, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("First String")));
+        UNLOG_TEST_CHECK(IsCaptured(8, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Second String")));
+        UNLOG_TEST_CHECK(IsCaptured(9, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Third String")));
+        UNLOG_TEST_CHECK(IsCaptured(10, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("First -42")));
+        UNLOG_TEST_CHECK(IsCaptured(11, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Third -42")));
+    }
+
+    static void TestConditions(FTestContext& Context)
+    {
+        using Unlog = TUnlog<>::WithTargets<Target::Capture>;
+        Target::Capture::Reset();
+
+        int32 NumEvaluated = 0;
+        const bool bFalse = NumCaptured() != 0;
+        Unlog::Log(bFalse, "Rejected");
+        Unlog::Logf(bFalse, TEXT("Rejected"));
+        UNCLOG(bFalse, Log)("Rejected");
+        UN_CLOG(bFalse, , Log, "Rejected");
+        UNCLOG(!bFalse, Log)("Accepted {0}", ++NumEvaluated);
+        Unlog::Log(!bFalse, "Accepted");
+
+        // Arguments of calls compiled out by the logger are never evaluated by the macros
+        using QuietUnlog = Unlog::WithCompileTimeVerbosity<ELogVerbosity::Warning>;
+        UNLOG(QuietUnlog, Log)("Rejected {0}", ++NumEvaluated);
+
+        FUnlogCallSiteQuery Query;
+        Query.Format = TEXT("Switched*");
+        FUnlogCallSite::SetEnabled(Query, false);
+        UNLOG(Log)("Switched off");
+        // Calls through the logging functions have no call site to switch
+        Unlog::Log("Switched off too");
+        FUnlogCallSite::ResetEnabled();
+
+        UNLOG_TEST_CHECK(NumCaptured() == 3);
+        UNLOG_TEST_CHECK(NumEvaluated == 1);
+        UNLOG_TEST_CHECK(IsCaptured(0, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Accepted 1")));
+        UNLOG_TEST_CHECK(IsCaptured(1, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Accepted")));
+        UNLOG_TEST_CHECK(IsCaptured(2, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Switched off too")));
+    }
+
+    static void TestFilters(FTestContext& Context)
+    {
+        using Unlog = TUnlog<>::WithTargets<Target::Capture>;
+        Target::Capture::Reset();
+
+        for (int32 Index = 0; Index < 9; ++Index)
+        {
+            Unlog::WithSampling<3>::Log("Sampled {0}", Index);
+            Unlog::WithRateLimit<1>::Log("Limited");
+        }
+        UNLOG_TEST_CHECK(NumCaptured() == 4);
+        UNLOG_TEST_CHECK(IsCaptured(0, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Sampled 0")));
+        UNLOG_TEST_CHECK(IsCaptured(1, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Limited")));
+        UNLOG_TEST_CHECK(IsCaptured(2, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Sampled 3")));
+        UNLOG_TEST_CHECK(IsCaptured(3, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Sampled 6")));
+
+        // Suppressed calls are still reported when no other call gets through
+        Target::Capture::Reset();
+        Unlog::Flush();
+        UNLOG_TEST_CHECK(NumCaptured() == 1);
+        UNLOG_TEST_CHECK(IsCaptured(0, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Rate limit suppressed 8 messages")));
+
+        // Loggers with different limits keep their own state, even for the same call site
+        Target::Capture::Reset();
+        const TCHAR Shared[] = TEXT("Shared {0}");
+        for (int32 Index = 0; Index < 3; ++Index)
+        {
+            Unlog::WithRateLimit<1>::Log(Shared, 1);
+            Unlog::WithRateLimit<1, 2>::Log(Shared, 2);
+        }
+        UNLOG_TEST_CHECK(NumCaptured() == 3);
+        UNLOG_TEST_CHECK(IsCaptured(0, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Shared 1")));
+        UNLOG_TEST_CHECK(IsCaptured(2, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Shared 2")));
+        Unlog::Flush();
+
+        // Async targets keep the order and deliver everything once flushed
+        Target::Capture::Reset();
+        for (int32 Index = 0; Index < 3; ++Index)
+        {
+            Unlog::WithAsync<EUnlogAsyncPolicy::Block>::Log("Async {0}", Index);
+        }
+        Unlog::Flush();
+        UNLOG_TEST_CHECK(NumCaptured() == 3);
+        UNLOG_TEST_CHECK(IsCaptured(2, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Async 2")));
+
+        Target::Capture::Reset();
+        using DedupUnlog = Unlog::WithDeduplication<>;
+        DedupUnlog::Warn("Repeated");
+        DedupUnlog::Warn("Repeated");
+        DedupUnlog::Warn("Repeated");
+        DedupUnlog::Warn("Different");
+        Unlog::Flush();
+        UNLOG_TEST_CHECK(NumCaptured() == 3);
+        UNLOG_TEST_CHECK(IsCaptured(0, TEXT("LogGeneral"), ELogVerbosity::Warning, TEXT("Repeated")));
+        UNLOG_TEST_CHECK(IsCaptured(1, TEXT("LogGeneral"), ELogVerbosity::Warning, TEXT("Previous message repeated 2 times")));
+        UNLOG_TEST_CHECK(IsCaptured(2, TEXT("LogGeneral"), ELogVerbosity::Warning, TEXT("Different")));
+
+        // Flushing reaches stages fed by others, even when they were created first
+        Target::Capture::Reset();
+        DedupUnlog::WithAsync<>::Warn("Queued");
+        DedupUnlog::WithAsync<>::Warn("Queued");
+        Unlog::Flush();
+        UNLOG_TEST_CHECK(NumCaptured() == 2);
+        UNLOG_TEST_CHECK(IsCaptured(0, TEXT("LogGeneral"), ELogVerbosity::Warning, TEXT("Queued")));
+        UNLOG_TEST_CHECK(IsCaptured(1, TEXT("LogGeneral"), ELogVerbosity::Warning, TEXT("Previous message repeated 1 times")));
+    }
+
+    static void TestMessageArgs(FTestContext& Context)
+    {
+        using Unlog = TUnlog<>::WithTargets<Target::CaptureArgs>;
+        using MixedUnlog = TUnlog<>::WithTargets<Target::Capture, Target::CaptureArgs>;
+        const TArray<FUnlogCapturedArgs>& Captured = Target::CaptureArgs::GetArgs();
+        Target::Capture::Reset();
+        Target::CaptureArgs::Reset();
+
+        const FString String(TEXT("String"));
+        const FName Name(TEXT("Name"));
+        const FText Text = FText::FromString(TEXT("Text"));
+        const uint64 Large = 18446744073709551615ull;
+
+        UNLOG(Log)("Args {0} {1} {2} {3} {4} {5} {6} {7}", String, Name, Text, -42, Large, 0.5f, TEXT("Wide"), "Ansi");
+        UNLOG(Log)("Macro {0}", String);
+        Unlog::Logf(TEXT("Printf %s"), *String);
+        MixedUnlog::Log("Mixed {0}", String);
+
+        // Messages are only formatted for targets needing the text
+        UNLOG_TEST_CHECK(Captured.Num() == 4);
+        UNLOG_TEST_CHECK(!Captured[0].bWasFormatted && Captured[0].NumArgs == 8);
+        UNLOG_TEST_CHECK(Captured[0].Rendered == TEXT("Args String Name Text -42 18446744073709551615 0.500000 Wide Ansi"));
+        UNLOG_TEST_CHECK(!Captured[1].bWasFormatted && Captured[1].Rendered == TEXT("Macro String"));
+        UNLOG_TEST_CHECK(Captured[2].bWasFormatted && Captured[2].NumArgs == 0 && Captured[2].Rendered == TEXT("Printf String"));
+        UNLOG_TEST_CHECK(Captured[3].bWasFormatted && Captured[3].Rendered == TEXT("Mixed String"));
+        UNLOG_TEST_CHECK(IsCaptured(0, TEXT("LogGeneral"), ELogVerbosity::Log, TEXT("Mixed String")));
+
+        // Encoded arguments render the same text offline, given the call site's format
+        TStringBuilder<256> Offline;
+        FUnlogArgReader::Render(Offline, Captured[0].CallSite->Text, Captured[0].Encoded.GetData(), Captured[0].Encoded.Num());
+        UNLOG_TEST_CHECK(Captured[0].Rendered == Offline.ToString());
+
+        // Strings are cut short to fit, arguments after them are left out
+        uint8 Small[16];
+        FUnlogArgWriter Writer(Small, sizeof(Small));
+        UnlogFormat::EncodeArg(Writer, String);
+        UnlogFormat::EncodeArg(Writer, 1);
+
+        TArray<FUnlogDecodedArg> Decoded;
+        UNLOG_TEST_CHECK(FUnlogArgReader::Decode(Small, Writer.Num(), Decoded));
+        // Each string takes a type byte and a uint16 length before its characters
+        UNLOG_TEST_CHECK(Decoded.Num() == 1 && Decoded[0].String == String.Left((sizeof(Small) - 3) / sizeof(TCHAR)));
+        UNLOG_TEST_CHECK(!FUnlogArgReader::Decode(Small, 2, Decoded));
+    }
+
+    static void TestFields(FTestContext& Context)
+    {
+        using Unlog = TUnlog<>::WithTargets<Target::Capture, Target::CaptureArgs>;
+        const TArray<FUnlogCapturedArgs>& Captured = Target::CaptureArgs::GetArgs();
+        Target::Capture::Reset();
+        Target::CaptureArgs::Reset();
+
+        const FString ActorName(TEXT("Bob \"the\" Builder"));
+        const int32 Health = -100;
+        const float Speed = 0.5f;
+        const bool bAlive = true;
+        UNLOG(Log)("Spawned {0}", TEXT("Pawn"), UNLOG_FIELD(ActorName), UNLOG_FIELD(Health), UNLOG_NAMED_FIELD(Speed, Speed * 2), UNLOG_FIELD(bAlive));
+
+        // Text targets get the fields appended to the message
+        const TCHAR* Expected = TEXT("Spawned Pawn ActorName=Bob \"the\" Builder Health=-100 Speed=1.000000 bAlive=1");
+        UNLOG_TEST_CHECK(IsCaptured(0, TEXT("LogGeneral"), ELogVerbosity::Log, Expected));
+        UNLOG_TEST_CHECK(Captured.Num() == 1 && Captured[0].NumArgs == 5);
+        if (Captured.Num() != 1)
+        {
+            return;
+        }
+
+        // Targets serializing the fields on their own can leave them out of the text
+        UNLOG_TEST_CHECK(Captured[0].RenderedWithoutFields == TEXT("Spawned Pawn"));
+
+        // Encoded fields keep their name and type
+        TArray<FUnlogDecodedArg> Decoded;
+        UNLOG_TEST_CHECK(FUnlogArgReader::Decode(Captured[0].Encoded.GetData(), Captured[0].Encoded.Num(), Decoded));
+        UNLOG_TEST_CHECK(Decoded.Num() == 5);
+        if (Decoded.Num() != 5)
+        {
+            return;
+        }
+
+        UNLOG_TEST_CHECK(Decoded[0].Name.IsEmpty() && Decoded[0].String == TEXT("Pawn"));
+        UNLOG_TEST_CHECK(Decoded[1].Name == TEXT("ActorName") && Decoded[1].Type == EUnlogArgType::String && Decoded[1].String == ActorName);
+        UNLOG_TEST_CHECK(Decoded[2].Name == TEXT("Health") && Decoded[2].Type == EUnlogArgType::Signed && Decoded[2].Signed == Health);
+        UNLOG_TEST_CHECK(Decoded[3].Name == TEXT("Speed") && Decoded[3].Type == EUnlogArgType::Double && Decoded[3].Double == 1.0);
+        UNLOG_TEST_CHECK(Decoded[4].Name == TEXT("bAlive") && Decoded[4].Type == EUnlogArgType::Bool && Decoded[4].Bool);
+
+        TStringBuilder<256> Offline;
+        FUnlogArgReader::Render(Offline, Captured[0].CallSite->Text, Captured[0].Encoded.GetData(), Captured[0].Encoded.Num());
+        UNLOG_TEST_CHECK(FCString::Strcmp(Offline.ToString(), Expected) == 0);
+
+        // JSON lines only hold the fields once, typed, and escape the strings
+        const TCHAR* ExpectedJson = TEXT("{\"time\":0.000000,\"category\":\"LogGeneral\",\"verbosity\":\"Log\",\"message\":\"Spawned Pawn\",")
+            TEXT("\"fields\":{\"ActorName\":\"Bob \\\"the\\\" Builder\",\"Health\":-100,\"Speed\":1,\"bAlive\":true}}");
+        TStringBuilder<256> Json;
+        FUnlogJsonLine::Build(Json, 0.0, *Captured[0].CallSite->Category, ELogVerbosity::Log, TEXT("Spawned Pawn"), Decoded.GetData(), Decoded.Num());
+        UNLOG_TEST_CHECK(FCString::Strcmp(Json.ToString(), ExpectedJson) == 0);
+
+        // Same line straight from the arguments of a logging call
+        const double DoubleSpeed = Speed * 2;
+        const FUnlogFormatArg Args[] = {
+            UnlogFormat::MakeArg(TEXT("Pawn")),
+            UnlogFormat::MakeArg(UNLOG_FIELD(ActorName)),
+            UnlogFormat::MakeArg(UNLOG_FIELD(Health)),
+            UnlogFormat::MakeArg(UNLOG_NAMED_FIELD(Speed, DoubleSpeed)),
+            UnlogFormat::MakeArg(UNLOG_FIELD(bAlive))
+        };
+        Json.Reset();
+        FUnlogJsonLine::Build(Json, 0.0, *Captured[0].CallSite->Category, ELogVerbosity::Log, TEXT("Spawned Pawn"), Args, UE_ARRAY_COUNT(Args));
+        UNLOG_TEST_CHECK(FCString::Strcmp(Json.ToString(), ExpectedJson) == 0);
+
+        Json.Reset();
+        FUnlogJsonLine::Build(Json, 0.0, *Captured[0].CallSite->Category, ELogVerbosity::Warning, TEXT("Line\nBreak"), (const FUnlogFormatArg*)nullptr, 0);
+        UNLOG_TEST_CHECK(FCString::Strcmp(Json.ToString(), TEXT("{\"time\":0.000000,\"category\":\"LogGeneral\",\"verbosity\":\"Warning\",\"message\":\"Line\\nBreak\"}")) == 0);
+    }
+
+    static void TestAllocations(FTestContext& Context)
+    {
+        using Unlog = TUnlog<>::WithTargets<Target::Capture>;
+        using QuietUnlog = Unlog::WithCompileTimeVerbosity<ELogVerbosity::Warning>;
+        const int32 NumCalls = 1000;
+
+        const FString String(TEXT("String"));
+        const FName Name(TEXT("Name"));
+        const FText Text = FText::FromString(TEXT("Text"));
+        const bool bFalse = NumCaptured() < 0;
+
+        FUnlogCallSiteQuery Query;
+        Query.Format = TEXT("Switched*");
+        FUnlogCallSite::SetEnabled(Query, false);
+
+        // First calls register call sites, parse formats and create loggers
+        const auto Filtered = [&]
+        {
+            Unlog::Verbose("Filtered {0} {1} {2}", String, Name, Text);
+            UNLOG(Verbose)("Filtered {0} {1} {2}", String, Name, Text);
+            Unlog::Log(bFalse, "Filtered {0} {1} {2}", String, Name, Text);
+            UNCLOG(bFalse, Log)("Filtered {0} {1} {2}", String, Name, Text);
+            QuietUnlog::Log("Filtered {0} {1} {2}", String, Name, Text);
+            UNLOG(Log)("Switched off {0} {1} {2}", String, Name, Text);
+        };
+        const auto Emitted = [&]
+        {
+            Unlog::Log("Emitted {0} {1} {2} {3}", String, Name, Text, NumCalls);
+            UNLOGF(Log)("Emitted %s %d", *String, NumCalls);
+        };
+        Filtered();
+        Emitted();
+        Target::Capture::Reset(NumCalls * 2);
+
+        {
+            FUnlogAllocationCounter Counter;
+            for (int32 Index = 0; Index < NumCalls; ++Index)
+            {
+                Filtered();
+            }
+            UNLOG_TEST_CHECK(Counter.GetNumAllocations() == 0);
+        }
+        {
+            FUnlogAllocationCounter Counter;
+            for (int32 Index = 0; Index < NumCalls; ++Index)
+            {
+                Emitted();
+            }
+            UNLOG_TEST_CHECK(Counter.GetNumAllocations() <= EmittedCallAllocationBudget * NumCalls * 2);
+        }
+        UNLOG_TEST_CHECK(NumCaptured() == NumCalls * 2);
+
+        FUnlogCallSite::ResetEnabled();
+        Target::Capture::Reset();
+    }
+
+    static void TestLatency(FTestContext& Context)
+    {
+        using Unlog = TUnlog<>::WithTargets<Target::Capture>;
+        const int32 NumCalls = 10000;
+        const FString String(TEXT("String"));
+
+        const auto MeasureNanoseconds = [&](const TFunction<void()>& Function)
+        {
+            Function();
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+            for (int32 Index = 0; Index < NumCalls; ++Index)
+            {
+                Function();
+            }
+            return (FPlatformTime::Cycles64() - StartCycles) * FPlatformTime::GetSecondsPerCycle64() * 1e9 / NumCalls;
+        };
+
+        const double Filtered = MeasureNanoseconds([&] { UNLOG(Verbose)("Filtered {0}", String); });
+        Target::Capture::Reset(NumCalls + 1);
+        const double Emitted = MeasureNanoseconds([&] { UNLOG(Log)("Emitted {0}", String); });
+        Target::Capture::Reset();
+
+        UNLOG_TEST_CHECK(Filtered < FilteredCallBudgetNanoseconds);
+        UNLOG_TEST_CHECK(Emitted < EmittedCallBudgetNanoseconds);
+    }
+
+    static void TestCategoryStats(FTestContext& Context)
+    {
+#if UNLOG_CATEGORY_STATS
+        using Unlog = TUnlog<>::WithTargets<Target::Capture>;
+        UNLOG_CATEGORY(LogUnlogTestStats)
+        FUnlogCategoryStats::Reset();
+
+        for (int32 Index = 0; Index < 10; ++Index)
+        {
+            Unlog::Log<LogUnlogTestStats>("Four");
+            Unlog::Verbose<LogUnlogTestStats>("Filtered");
+        }
+        Unlog::WithRateLimit<1>::Log<LogUnlogTestStats>("Stats limited");
+        Unlog::WithRateLimit<1>::Log<LogUnlogTestStats>("Stats limited");
+
+        // Never formatted, so it adds no bytes
+        TUnlog<>::WithTargets<Target::CaptureArgs>::Log<LogUnlogTestStats>("Unformatted {0}", 7);
+        Target::Capture::Reset();
+        Target::CaptureArgs::Reset();
+
+        const TArray<FUnlogCategoryStats> AllStats = FUnlogCategoryStats::Collect();
+        UNLOG_TEST_CHECK(AllStats.Num() == 1);
+        if (AllStats.Num() == 1)
+        {
+            const FUnlogCategoryStats& Stats = AllStats[0];
+            UNLOG_TEST_CHECK(Stats.Category == FName(TEXT("LogUnlogTestStats")));
+            UNLOG_TEST_CHECK(Stats.NumEmitted == 12);
+            // Verbosity rejections are only counted when opted in
+            UNLOG_TEST_CHECK(Stats.NumFiltered == (UNLOG_CATEGORY_STATS_VERBOSITY ? 11 : 1));
+            UNLOG_TEST_CHECK(Stats.NumFormattedBytes == (10 * 4 + 13) * sizeof(TCHAR));
+            UNLOG_TEST_CHECK(Stats.FormatCycles > 0 && Stats.TargetCycles > 0);
+        }
+
+        FUnlogCategoryStats::Reset();
+        UNLOG_TEST_CHECK(FUnlogCategoryStats::Collect().Num() == 0);
+#endif
+    }
+#else
+    static void TestCompiledOut(FTestContext& Context)
+    {
+        using Unlog = TUnlog<>::WithTargets<Target::Capture>;
+        const FString String(TEXT("String"));
+        Target::Capture::Reset();
+
+        FUnlogAllocationCounter Counter;
+        Unlog::Error("Compiled out {0}", String);
+        UNLOG(Error)("Compiled out {0}", String);
+        UN_LOG(, Error, "Compiled out {0}", String);
+        UNLOGF(Error)("Compiled out %s", *String);
+
+        UNLOG_TEST_CHECK(NumCaptured() == 0);
+        UNLOG_TEST_CHECK(Counter.GetNumAllocations() == 0);
+    }
+#endif // UNLOG_ENABLED
 };
@@ -0,0 +1,23 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+#include <mutex>
+
+namespace ENamedThreads
+{
+    enum Type : int32
+    {
+        AnyThread,
+        GameThread,
+    };
+}
+
+// There's no task graph here, tasks run right away on the calling thread one at a time
+template<typename FunctorType>
+void AsyncTask(ENamedThreads::Type Thread, FunctorType&& Function)
+{
+    static std::mutex Mutex;
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Function();
+}
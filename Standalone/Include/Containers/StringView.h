@@ -0,0 +1,52 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+
+template<typename CharType>
+class TStringView
+{
+public:
+    constexpr TStringView() = default;
+    constexpr TStringView(const CharType* InData, int32 InSize) : DataPtr(InData), Size(InSize) {}
+    TStringView(const CharType* InData) : DataPtr(InData), Size(InData ? TCString<CharType>::Strlen(InData) : 0) {}
+
+    template<typename StringType, typename = decltype(std::declval<const StringType&>().Len())>
+    TStringView(const StringType& String) : DataPtr(*String), Size(String.Len()) {}
+
+    constexpr const CharType* GetData() const { return DataPtr; }
+    constexpr int32 Len() const { return Size; }
+    constexpr bool IsEmpty() const { return Size == 0; }
+
+    const CharType& operator[](int32 Index) const { check(Index >= 0 && Index < Size); return DataPtr[Index]; }
+
+    bool Equals(TStringView Other) const
+    {
+        return Size == Other.Size && std::char_traits<CharType>::compare(DataPtr, Other.DataPtr, Size) == 0;
+    }
+
+    bool operator==(TStringView Other) const { return Equals(Other); }
+    bool operator!=(TStringView Other) const { return !Equals(Other); }
+
+    bool Contains(TStringView Search) const
+    {
+        for (int32 Index = 0; Index + Search.Size <= Size; ++Index)
+        {
+            if (std::char_traits<CharType>::compare(DataPtr + Index, Search.DataPtr, Search.Size) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const CharType* begin() const { return DataPtr; }
+    const CharType* end() const { return DataPtr + Size; }
+
+private:
+    const CharType* DataPtr = nullptr;
+    int32 Size = 0;
+};
+
+typedef TStringView<TCHAR> FStringView;
+typedef TStringView<ANSICHAR> FAnsiStringView;
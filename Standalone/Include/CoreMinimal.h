@@ -0,0 +1,786 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+// ------------------------------------------------------------------------------------
+// Engine-free stand-in for the parts of CoreMinimal.h Unlog depends on.
+//
+// Only meant to let Unlog's headers be compiled, tested and profiled with a plain
+// compiler. Behaviour mirrors the engine where Unlog relies on it (formatting rules,
+// verbosity ordering, output device routing) and is otherwise kept minimal.
+// ------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+#include <cwctype>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifndef UE_BUILD_SHIPPING
+#define UE_BUILD_SHIPPING 0
+#endif
+
+#ifndef WITH_EDITOR
+#define WITH_EDITOR 0
+#endif
+
+// ------------------------------------------------------------------------------------
+// Platform types and macros
+// ------------------------------------------------------------------------------------
+
+typedef std::int8_t   int8;
+typedef std::int16_t  int16;
+typedef std::int32_t  int32;
+typedef std::int64_t  int64;
+typedef std::uint8_t  uint8;
+typedef std::uint16_t uint16;
+typedef std::uint32_t uint32;
+typedef std::uint64_t uint64;
+typedef std::uintptr_t UPTRINT;
+typedef std::intptr_t  PTRINT;
+typedef std::size_t    SIZE_T;
+
+typedef char    ANSICHAR;
+typedef wchar_t WIDECHAR;
+typedef wchar_t TCHAR;
+
+#define UNLOG_SHIM_TEXT_PASTE(x) L ## x
+#define TEXT(x) UNLOG_SHIM_TEXT_PASTE(x)
+
+#define FORCEINLINE inline __attribute__((always_inline))
+#define FORCENOINLINE __attribute__((noinline))
+#define INDEX_NONE (-1)
+#define MAX_uint16 ((uint16)0xffff)
+#define MAX_uint32 ((uint32)0xffffffff)
+#define MAX_int32 ((int32)0x7fffffff)
+#define UE_ARRAY_COUNT(Array) (sizeof(Array) / sizeof((Array)[0]))
+#define PLATFORM_CACHE_LINE_SIZE 64
+#define PLATFORM_WINDOWS 0
+#define PLATFORM_MAC 0
+#define PLATFORM_LINUX 1
+#define PLATFORM_UNIX 1
+
+#define check(expr) assert(expr)
+#define checkf(expr, ...) assert(expr)
+#define ensure(expr) (expr)
+
+struct FMath
+{
+    template<typename T> static constexpr FORCEINLINE T Min(const T A, const T B) { return A < B ? A : B; }
+    template<typename T> static constexpr FORCEINLINE T Max(const T A, const T B) { return A > B ? A : B; }
+    template<typename T> static constexpr FORCEINLINE T Clamp(const T X, const T MinValue, const T MaxValue) { return X < MinValue ? MinValue : (X > MaxValue ? MaxValue : X); }
+    static FORCEINLINE bool IsFinite(double A) { return std::isfinite(A); }
+    static FORCEINLINE uint64 FloorLog2_64(uint64 Value) { return Value == 0 ? 0 : 63 - __builtin_clzll(Value); }
+};
+
+struct FMemory
+{
+    static void* Malloc(SIZE_T Count, uint32 Alignment = 0);
+    static void Free(void* Original);
+
+    static FORCEINLINE void* Memcpy(void* Dest, const void* Src, SIZE_T Count) { return std::memcpy(Dest, Src, Count); }
+    static FORCEINLINE int32 Memcmp(const void* A, const void* B, SIZE_T Count) { return std::memcmp(A, B, Count); }
+    static FORCEINLINE void* Memzero(void* Dest, SIZE_T Count) { return std::memset(Dest, 0, Count); }
+};
+
+// ------------------------------------------------------------------------------------
+// Templates
+// ------------------------------------------------------------------------------------
+
+template<bool Predicate, typename Result = void>
+struct TEnableIf {};
+
+template<typename Result>
+struct TEnableIf<true, Result> { typedef Result Type; };
+
+template<typename... Types>
+struct TAnd;
+
+template<>
+struct TAnd<> { static constexpr bool Value = true; };
+
+template<typename Type, typename... Types>
+struct TAnd<Type, Types...> { static constexpr bool Value = Type::Value && TAnd<Types...>::Value; };
+
+template<typename... Types>
+struct TOr;
+
+template<>
+struct TOr<> { static constexpr bool Value = false; };
+
+template<typename Type, typename... Types>
+struct TOr<Type, Types...> { static constexpr bool Value = Type::Value || TOr<Types...>::Value; };
+
+template<typename Type>
+struct TNot { static constexpr bool Value = !Type::Value; };
+
+template<typename T, typename... Args>
+struct TIsConstructible { static constexpr bool Value = std::is_constructible<T, Args...>::value; };
+
+template<typename A, typename B>
+struct TIsSame { static constexpr bool Value = std::is_same<A, B>::value; };
+
+template<typename T>
+struct TIsIntegral { static constexpr bool Value = std::is_integral<T>::value; };
+
+template<typename T>
+struct TIsFloatingPoint { static constexpr bool Value = std::is_floating_point<T>::value; };
+
+template<typename T>
+struct TIsArithmetic { static constexpr bool Value = std::is_arithmetic<T>::value; };
+
+template<typename T>
+struct TIsSigned { static constexpr bool Value = std::is_signed<T>::value; };
+
+template<typename T>
+struct TIsEnum { static constexpr bool Value = std::is_enum<T>::value; };
+
+template<typename T>
+struct TRemoveReference { typedef typename std::remove_reference<T>::type Type; };
+
+template<typename T>
+struct TDecay { typedef typename std::decay<T>::type Type; };
+
+template<typename T>
+FORCEINLINE T&& Forward(typename std::remove_reference<T>::type& Obj) { return static_cast<T&&>(Obj); }
+
+template<typename T>
+FORCEINLINE T&& Forward(typename std::remove_reference<T>::type&& Obj) { return static_cast<T&&>(Obj); }
+
+template<typename T>
+FORCEINLINE typename std::remove_reference<T>::type&& MoveTemp(T&& Obj) { return static_cast<typename std::remove_reference<T>::type&&>(Obj); }
+
+FORCEINLINE uint32 PointerHash(const void* Key)
+{
+    // Ignoring the lower bits since pointers are usually aligned, then mixing like the engine's MurmurFinalize32
+    uint32 Hash = static_cast<uint32>(reinterpret_cast<UPTRINT>(Key) >> 4);
+    Hash ^= Hash >> 16;
+    Hash *= 0x85ebca6b;
+    Hash ^= Hash >> 13;
+    Hash *= 0xc2b2ae35;
+    Hash ^= Hash >> 16;
+    return Hash;
+}
+
+template<typename T>
+typename std::add_rvalue_reference<T>::type DeclVal();
+
+template<typename FuncType>
+using TFunction = std::function<FuncType>;
+
+template<typename FuncType>
+using TFunctionRef = std::function<FuncType>;
+
+// ------------------------------------------------------------------------------------
+// Logging verbosity
+// ------------------------------------------------------------------------------------
+
+namespace ELogVerbosity
+{
+    enum Type : uint8
+    {
+        NoLogging = 0,
+        Fatal,
+        Error,
+        Warning,
+        Display,
+        Log,
+        Verbose,
+        VeryVerbose,
+        All = VeryVerbose,
+        NumVerbosity,
+        VerbosityMask = 0xf,
+        SetColor = 0x40,
+        BreakOnLog = 0x80
+    };
+}
+
+const TCHAR* ToString(ELogVerbosity::Type Verbosity);
+
+// ------------------------------------------------------------------------------------
+// Containers
+// ------------------------------------------------------------------------------------
+
+struct FDefaultAllocator {};
+
+template<int32 NumInlineElements>
+struct TInlineAllocator {};
+
+template<typename ElementType, typename Allocator = FDefaultAllocator>
+class TArray
+{
+public:
+    TArray() = default;
+    TArray(std::initializer_list<ElementType> InitList) : Data(InitList) {}
+
+    int32 Num() const { return static_cast<int32>(Data.size()); }
+    bool IsEmpty() const { return Data.empty(); }
+    bool IsValidIndex(int32 Index) const { return Index >= 0 && Index < Num(); }
+
+    ElementType* GetData() { return Data.data(); }
+    const ElementType* GetData() const { return Data.data(); }
+
+    ElementType& operator[](int32 Index) { check(IsValidIndex(Index)); return Data[Index]; }
+    const ElementType& operator[](int32 Index) const { check(IsValidIndex(Index)); return Data[Index]; }
+
+    ElementType& Last() { check(Num() > 0); return Data.back(); }
+    const ElementType& Last() const { check(Num() > 0); return Data.back(); }
+
+    int32 Add(const ElementType& Item) { Data.push_back(Item); return Num() - 1; }
+    int32 Add(ElementType&& Item) { Data.push_back(MoveTemp(Item)); return Num() - 1; }
+
+    template<typename... ArgTypes>
+    int32 Emplace(ArgTypes&&... Args) { Data.emplace_back(Forward<ArgTypes>(Args)...); return Num() - 1; }
+
+    void Push(const ElementType& Item) { Add(Item); }
+    ElementType Pop() { check(Num() > 0); ElementType Result = MoveTemp(Data.back()); Data.pop_back(); return Result; }
+
+    void RemoveAt(int32 Index) { check(IsValidIndex(Index)); Data.erase(Data.begin() + Index); }
+    int32 Remove(const ElementType& Item) { const int32 Before = Num(); Data.erase(std::remove(Data.begin(), Data.end(), Item), Data.end()); return Before - Num(); }
+    void Reserve(int32 Number) { Data.reserve(Number); }
+    void SetNum(int32 Number) { Data.resize(Number); }
+    void Reset(int32 NewSize = 0) { Data.clear(); Data.reserve(NewSize); }
+    void Empty() { Data.clear(); Data.shrink_to_fit(); }
+
+    template<typename Predicate>
+    void Sort(Predicate Pred) { std::stable_sort(Data.begin(), Data.end(), Pred); }
+
+    template<typename Predicate>
+    ElementType* FindByPredicate(Predicate Pred)
+    {
+        for (ElementType& Element : Data)
+        {
+            if (Pred(Element))
+            {
+                return &Element;
+            }
+        }
+        return nullptr;
+    }
+
+    typename std::vector<ElementType>::iterator begin() { return Data.begin(); }
+    typename std::vector<ElementType>::iterator end() { return Data.end(); }
+    typename std::vector<ElementType>::const_iterator begin() const { return Data.begin(); }
+    typename std::vector<ElementType>::const_iterator end() const { return Data.end(); }
+
+private:
+    std::vector<ElementType> Data;
+};
+
+// ------------------------------------------------------------------------------------
+// Strings
+// ------------------------------------------------------------------------------------
+
+template<typename CharType>
+struct TCString
+{
+    static int32 Atoi(const CharType* String)
+    {
+        int32 Value = 0;
+        bool bNegative = *String == '-';
+        for (String += bNegative ? 1 : 0; *String >= '0' && *String <= '9'; ++String) { Value = Value * 10 + (*String - '0'); }
+        return bNegative ? -Value : Value;
+    }
+
+    static int32 Strlen(const CharType* String)
+    {
+        return static_cast<int32>(std::char_traits<CharType>::length(String));
+    }
+
+    static int32 Strcmp(const CharType* String1, const CharType* String2)
+    {
+        for (; *String1 == *String2; ++String1, ++String2)
+        {
+            if (*String1 == 0)
+            {
+                return 0;
+            }
+        }
+        return *String1 < *String2 ? -1 : 1;
+    }
+
+    // Writes the formatted string to Dest, returns -1 when it doesn't fit
+    static int32 GetVarArgs(CharType* Dest, SIZE_T DestSize, const CharType*& Fmt, va_list ArgPtr);
+
+    static const CharType* Strstr(const CharType* String, const CharType* Find)
+    {
+        const SIZE_T FindLength = std::char_traits<CharType>::length(Find);
+        for (; *String; ++String)
+        {
+            if (std::char_traits<CharType>::compare(String, Find, FindLength) == 0)
+            {
+                return String;
+            }
+        }
+        return FindLength == 0 ? String : nullptr;
+    }
+};
+
+template<>
+int32 TCString<TCHAR>::GetVarArgs(TCHAR* Dest, SIZE_T DestSize, const TCHAR*& Fmt, va_list ArgPtr);
+
+typedef TCString<TCHAR> FCString;
+typedef TCString<ANSICHAR> FCStringAnsi;
+
+template<typename CharType>
+class TStringBuilderBase;
+typedef TStringBuilderBase<TCHAR> FStringBuilderBase;
+
+struct FStringFormatArg;
+typedef TArray<FStringFormatArg> FStringFormatOrderedArguments;
+
+class FString
+{
+public:
+    FString() = default;
+    FString(const TCHAR* Str) : Data(Str ? Str : L"") {}
+    FString(int32 InCount, const TCHAR* Str) : Data(Str, InCount) {}
+    explicit FString(const ANSICHAR* Str);
+
+    int32 Len() const { return static_cast<int32>(Data.size()); }
+    bool IsEmpty() const { return Data.empty(); }
+    const TCHAR* operator*() const { return Data.c_str(); }
+    FString Left(int32 Count) const { return FString(Count < Len() ? Count : Len(), Data.c_str()); }
+
+    void Reserve(int32 CharacterCount) { Data.reserve(CharacterCount); }
+    void Reset(int32 NewSize = 0) { Data.clear(); Data.reserve(NewSize); }
+    void Empty() { Data.clear(); Data.shrink_to_fit(); }
+
+    FString& Append(const TCHAR* Str, int32 Count) { Data.append(Str, Count); return *this; }
+    FString& Append(const TCHAR* Str) { Data.append(Str); return *this; }
+    FString& Append(const FString& Str) { Data.append(Str.Data); return *this; }
+    FString& AppendChar(TCHAR Char) { Data.push_back(Char); return *this; }
+    FString& AppendChars(const TCHAR* Str, int32 Count) { return Append(Str, Count); }
+
+    FString& operator+=(const TCHAR* Str) { return Append(Str); }
+    FString& operator+=(const FString& Str) { return Append(Str); }
+    FString& operator+=(TCHAR Char) { return AppendChar(Char); }
+
+    friend FString operator+(FString Lhs, const FString& Rhs) { Lhs += Rhs; return Lhs; }
+    friend FString operator+(FString Lhs, const TCHAR* Rhs) { Lhs += Rhs; return Lhs; }
+
+    bool operator==(const FString& Other) const { return Data == Other.Data; }
+    bool operator!=(const FString& Other) const { return Data != Other.Data; }
+    bool operator==(const TCHAR* Other) const { return Data == Other; }
+    bool operator!=(const TCHAR* Other) const { return Data != Other; }
+
+    bool Contains(const TCHAR* SubStr) const { return Data.find(SubStr) != std::wstring::npos; }
+    bool MatchesWildcard(const FString& Wildcard) const { return MatchesWildcardImpl(Data.c_str(), *Wildcard); }
+    bool Split(const FString& InS, FString* LeftS, FString* RightS) const
+    {
+        const size_t Index = Data.find(InS.Data);
+        if (Index == std::wstring::npos) { return false; }
+        if (LeftS) { *LeftS = FString((int32)Index, Data.c_str()); }
+        if (RightS) { *RightS = FString(Data.c_str() + Index + InS.Data.size()); }
+        return true;
+    }
+    // Case insensitive glob with * and ?
+    static bool MatchesWildcardImpl(const TCHAR* String, const TCHAR* Wildcard)
+    {
+        if (*Wildcard == 0) { return *String == 0; }
+        if (*Wildcard == '*') { return MatchesWildcardImpl(String, Wildcard + 1) || (*String && MatchesWildcardImpl(String + 1, Wildcard)); }
+        if (*String && (*Wildcard == '?' || std::towlower(*String) == std::towlower(*Wildcard))) { return MatchesWildcardImpl(String + 1, Wildcard + 1); }
+        return false;
+    }
+    bool StartsWith(const TCHAR* Prefix) const { return Data.compare(0, std::wcslen(Prefix), Prefix) == 0; }
+    bool EndsWith(const TCHAR* Suffix) const
+    {
+        const SIZE_T SuffixLen = std::wcslen(Suffix);
+        return Data.size() >= SuffixLen && Data.compare(Data.size() - SuffixLen, SuffixLen, Suffix) == 0;
+    }
+
+    template<typename... ArgTypes>
+    static FString Printf(const TCHAR* Fmt, ArgTypes... Args)
+    {
+        return PrintfImpl(Fmt, Args...);
+    }
+
+    static FString PrintfImpl(const TCHAR* Fmt, ...);
+    static FString VPrintf(const TCHAR* Fmt, va_list Args);
+    static FString Format(const TCHAR* InFormatString, const FStringFormatOrderedArguments& InOrderedArguments);
+
+private:
+    std::wstring Data;
+};
+
+FORCEINLINE uint32 GetTypeHash(const FString& Str)
+{
+    return static_cast<uint32>(std::hash<std::wstring>()(std::wstring(*Str, Str.Len())));
+}
+
+#define UTF8_TO_TCHAR(Str) (*FString(static_cast<const ANSICHAR*>(Str)))
+#define ANSI_TO_TCHAR(Str) UTF8_TO_TCHAR(Str)
+
+class FTCHARToUTF8
+{
+public:
+    explicit FTCHARToUTF8(const TCHAR* Source);
+    const ANSICHAR* Get() const { return Converted.c_str(); }
+    int32 Length() const { return static_cast<int32>(Converted.size()); }
+
+private:
+    std::string Converted;
+};
+
+#define TCHAR_TO_UTF8(Str) (FTCHARToUTF8(Str).Get())
+
+// Converts into an inline buffer like the engine's, only longer strings allocate
+class FUTF8ToTCHAR
+{
+public:
+    explicit FUTF8ToTCHAR(const ANSICHAR* Source);
+    const TCHAR* Get() const { return Overflow.empty() ? Inline : Overflow.c_str(); }
+    int32 Length() const { return Len; }
+
+private:
+    static constexpr int32 InlineSize = 128;
+    TCHAR Inline[InlineSize];
+    std::wstring Overflow;
+    int32 Len;
+};
+
+// Interned like the engine's name table, so copying and comparing names is free
+class FName
+{
+public:
+    FName() = default;
+    FName(const TCHAR* Name) : Entry(FindOrAdd(FString(Name))) {}
+    FName(const ANSICHAR* Name) : Entry(FindOrAdd(FString(Name))) {}
+    explicit FName(const FString& Name) : Entry(FindOrAdd(Name)) {}
+
+    FString ToString() const { return Entry ? *Entry : FString(); }
+    void ToString(FString& Out) const { Out = ToString(); }
+    void AppendString(FString& Out) const { if (Entry) { Out += *Entry; } }
+    void AppendString(FStringBuilderBase& Out) const;
+    bool IsNone() const { return Entry == nullptr; }
+
+    bool operator==(const FName& Other) const { return Entry == Other.Entry; }
+    bool operator!=(const FName& Other) const { return Entry != Other.Entry; }
+
+    friend uint32 GetTypeHash(const FName& Name) { return PointerHash(Name.Entry); }
+
+private:
+    // Entries are never freed, an empty name is None
+    static const FString* FindOrAdd(const FString& Name);
+
+    const FString* Entry = nullptr;
+};
+
+#define NAME_None FName()
+
+class FText
+{
+public:
+    static FText FromString(const FString& InString) { FText Text; Text.Value = InString; return Text; }
+    static FText FromName(const FName& InName) { return FromString(InName.ToString()); }
+    const FString& ToString() const { return Value; }
+    bool IsEmpty() const { return Value.IsEmpty(); }
+
+private:
+    FString Value;
+};
+
+struct FStringFormatArg
+{
+    enum EType { Int, UInt, Double, String, StringLiteral };
+
+    EType Type;
+    union
+    {
+        int64 IntValue;
+        uint64 UIntValue;
+        double DoubleValue;
+        const TCHAR* StringLiteralValue;
+    };
+    FString StringValue;
+
+    FStringFormatArg(const int32 Value) : Type(Int), IntValue(Value) {}
+    FStringFormatArg(const uint32 Value) : Type(UInt), UIntValue(Value) {}
+    FStringFormatArg(const int64 Value) : Type(Int), IntValue(Value) {}
+    FStringFormatArg(const uint64 Value) : Type(UInt), UIntValue(Value) {}
+    FStringFormatArg(const float Value) : Type(Double), DoubleValue(Value) {}
+    FStringFormatArg(const double Value) : Type(Double), DoubleValue(Value) {}
+    FStringFormatArg(FString Value) : Type(String), IntValue(0), StringValue(MoveTemp(Value)) {}
+    FStringFormatArg(const ANSICHAR* Value) : Type(String), IntValue(0), StringValue(Value) {}
+    FStringFormatArg(const TCHAR* Value) : Type(StringLiteral), StringLiteralValue(Value) {}
+
+    FStringFormatArg(const FStringFormatArg&) = default;
+    FStringFormatArg& operator=(const FStringFormatArg&) = default;
+};
+
+FString LexToStringImpl(int64 Value);
+FString LexToStringImpl(uint64 Value);
+FString LexToStringImpl(double Value);
+
+template<typename T>
+FORCEINLINE typename TEnableIf<TIsArithmetic<T>::Value, FString>::Type LexToString(const T Value)
+{
+    using PromotedType = typename std::conditional<TIsFloatingPoint<T>::Value, double, typename std::conditional<TIsSigned<T>::Value, int64, uint64>::type>::type;
+    return LexToStringImpl(static_cast<PromotedType>(Value));
+}
+
+void AppendToString(const FStringFormatArg& Arg, FString& StringToAppendTo);
+
+// ------------------------------------------------------------------------------------
+// Maps
+// ------------------------------------------------------------------------------------
+
+template<typename T>
+FORCEINLINE typename TEnableIf<std::is_integral<T>::value || std::is_enum<T>::value, uint32>::Type GetTypeHash(const T Value)
+{
+    return static_cast<uint32>(std::hash<uint64>()(static_cast<uint64>(Value)));
+}
+
+template<typename T>
+FORCEINLINE uint32 GetTypeHash(T* const Value)
+{
+    return PointerHash(Value);
+}
+
+template<typename KeyType, typename ValueType>
+struct TPair
+{
+    KeyType Key;
+    ValueType Value;
+
+    TPair() = default;
+    TPair(const KeyType& InKey, const ValueType& InValue) : Key(InKey), Value(InValue) {}
+};
+
+// Insertion ordered, removal swaps with the last element just like TSparseArray holes would reorder
+template<typename KeyType, typename ValueType>
+class TMap
+{
+    struct FHasher
+    {
+        size_t operator()(const KeyType& Key) const { return GetTypeHash(Key); }
+    };
+
+public:
+    using ElementType = TPair<KeyType, ValueType>;
+
+    int32 Num() const { return Pairs.Num(); }
+
+    ValueType* Find(const KeyType& Key)
+    {
+        auto It = Index.find(Key);
+        return It != Index.end() ? &Pairs[It->second].Value : nullptr;
+    }
+
+    const ValueType* Find(const KeyType& Key) const
+    {
+        auto It = Index.find(Key);
+        return It != Index.end() ? &Pairs[It->second].Value : nullptr;
+    }
+
+    bool Contains(const KeyType& Key) const { return Index.count(Key) != 0; }
+
+    ValueType& Add(const KeyType& Key, const ValueType& Value)
+    {
+        if (ValueType* Existing = Find(Key))
+        {
+            *Existing = Value;
+            return *Existing;
+        }
+        Index.emplace(Key, Pairs.Num());
+        return Pairs[Pairs.Add(ElementType{ Key, Value })].Value;
+    }
+
+    ValueType& FindOrAdd(const KeyType& Key)
+    {
+        if (ValueType* Existing = Find(Key))
+        {
+            return *Existing;
+        }
+        Index.emplace(Key, Pairs.Num());
+        return Pairs[Pairs.Add(ElementType{ Key, ValueType() })].Value;
+    }
+
+    int32 Remove(const KeyType& Key)
+    {
+        auto It = Index.find(Key);
+        if (It == Index.end())
+        {
+            return 0;
+        }
+        const int32 Removed = static_cast<int32>(It->second);
+        Index.erase(It);
+        if (Removed != Pairs.Num() - 1)
+        {
+            Pairs[Removed] = MoveTemp(Pairs.Last());
+            Index[Pairs[Removed].Key] = Removed;
+        }
+        Pairs.Pop();
+        return 1;
+    }
+
+    void Reset() { Pairs.Reset(); Index.clear(); }
+    void Empty() { Pairs.Empty(); Index.clear(); }
+
+    ElementType* begin() { return Pairs.GetData(); }
+    ElementType* end() { return Pairs.GetData() + Pairs.Num(); }
+    const ElementType* begin() const { return Pairs.GetData(); }
+    const ElementType* end() const { return Pairs.GetData() + Pairs.Num(); }
+
+private:
+    TArray<ElementType> Pairs;
+    std::unordered_map<KeyType, size_t, FHasher> Index;
+};
+
+// ------------------------------------------------------------------------------------
+// Shared pointers
+// ------------------------------------------------------------------------------------
+
+template<typename ObjectType>
+struct TRawPtrProxy
+{
+    ObjectType* Object;
+};
+
+template<typename ObjectType>
+FORCEINLINE TRawPtrProxy<ObjectType> MakeShareable(ObjectType* InObject)
+{
+    return TRawPtrProxy<ObjectType>{ InObject };
+}
+
+template<typename ObjectType>
+class TSharedRef
+{
+public:
+    template<typename OtherType>
+    TSharedRef(TRawPtrProxy<OtherType> Proxy) : Pointer(Proxy.Object) {}
+
+    template<typename OtherType>
+    TSharedRef(const TSharedRef<OtherType>& Other) : Pointer(Other.Pointer) {}
+
+    explicit TSharedRef(std::shared_ptr<ObjectType> InPointer) : Pointer(MoveTemp(InPointer)) {}
+
+    ObjectType* operator->() const { return Pointer.get(); }
+    ObjectType& Get() const { return *Pointer; }
+
+    std::shared_ptr<ObjectType> Pointer;
+};
+
+template<typename CastToType, typename CastFromType>
+FORCEINLINE TSharedRef<CastToType> StaticCastSharedRef(const TSharedRef<CastFromType>& InSharedRef)
+{
+    return TSharedRef<CastToType>(std::static_pointer_cast<CastToType>(InSharedRef.Pointer));
+}
+
+template<typename ObjectType, typename... ArgTypes>
+FORCEINLINE TSharedRef<ObjectType> MakeShared(ArgTypes&&... Args)
+{
+    return TSharedRef<ObjectType>(std::make_shared<ObjectType>(Forward<ArgTypes>(Args)...));
+}
+
+// ------------------------------------------------------------------------------------
+// Math
+// ------------------------------------------------------------------------------------
+
+struct FColor
+{
+    uint8 B = 0, G = 0, R = 0, A = 255;
+
+    FColor() = default;
+    constexpr FColor(uint8 InR, uint8 InG, uint8 InB, uint8 InA = 255) : B(InB), G(InG), R(InR), A(InA) {}
+
+    static const FColor White;
+    static const FColor Black;
+    static const FColor Red;
+    static const FColor Green;
+    static const FColor Blue;
+    static const FColor Yellow;
+    static const FColor Cyan;
+    static const FColor Magenta;
+    static const FColor Orange;
+};
+
+struct FVector2D
+{
+    float X = 1.f, Y = 1.f;
+};
+
+// ------------------------------------------------------------------------------------
+// Output devices
+// ------------------------------------------------------------------------------------
+
+class FOutputDevice
+{
+public:
+    virtual ~FOutputDevice() {}
+    virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category) = 0;
+    virtual void Flush() {}
+
+    void Log(const TCHAR* V) { Serialize(V, ELogVerbosity::Log, FName()); }
+    template<typename... ArgTypes>
+    void Logf(const TCHAR* Fmt, ArgTypes... Args) { Log(*FString::Printf(Fmt, Args...)); }
+};
+
+// Routes serialized lines to every registered device, stdout when none is registered
+class FOutputDeviceRedirector : public FOutputDevice
+{
+public:
+    virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category) override;
+    virtual void Flush() override;
+
+    void AddOutputDevice(FOutputDevice* OutputDevice);
+    void RemoveOutputDevice(FOutputDevice* OutputDevice);
+
+    static FOutputDeviceRedirector* Get();
+
+private:
+    TArray<FOutputDevice*> OutputDevices;
+};
+
+#define GLog (FOutputDeviceRedirector::Get())
+
+// Editor feedback context, not present outside the editor so null here
+class FFeedbackContext : public FOutputDevice
+{
+};
+
+extern FFeedbackContext* GWarn;
+
+// The thread static initialization ran on, which is the one running main()
+bool IsInGameThread();
+
+struct FMsg
+{
+    template<typename... ArgTypes>
+    static void Logf(const ANSICHAR* File, int32 Line, const FName& Category, ELogVerbosity::Type Verbosity, const TCHAR* Fmt, ArgTypes... Args)
+    {
+        LogfImpl(File, Line, Category, Verbosity, Fmt, Args...);
+    }
+
+    static void LogfImpl(const ANSICHAR* File, int32 Line, const FName& Category, ELogVerbosity::Type Verbosity, const TCHAR* Fmt, ...);
+};
+
+// ------------------------------------------------------------------------------------
+// Archives
+// ------------------------------------------------------------------------------------
+
+// Only the writing side, see IFileManager::CreateFileWriter
+class FArchive
+{
+public:
+    virtual ~FArchive() {}
+    virtual void Serialize(void* V, int64 Length) = 0;
+    virtual void Flush() {}
+    virtual bool Close() { return true; }
+};
+
+// Mimics the engine PCH making GEngine visible to code only including CoreMinimal
+#include <Engine/Engine.h>
@@ -0,0 +1,40 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Logging/TokenizedMessage.h>
+
+// Records what it's given so tests can inspect it
+class IMessageLogListing
+{
+public:
+    void AddMessage(const TSharedRef<FTokenizedMessage>& NewMessage, bool bMirrorToOutputLog = true)
+    {
+        Messages.Add(NewMessage);
+        ++NumAddCalls;
+    }
+
+    void AddMessages(const TArray< TSharedRef<FTokenizedMessage> >& NewMessages, bool bMirrorToOutputLog = true)
+    {
+        for (const TSharedRef<FTokenizedMessage>& Message : NewMessages)
+        {
+            Messages.Add(Message);
+        }
+        ++NumAddCalls;
+    }
+
+    void SetLabel(const FText& InLabel)
+    {
+        Label = InLabel;
+        ++NumSetLabelCalls;
+    }
+
+    const FText& GetLabel() const { return Label; }
+
+    TArray< TSharedRef<FTokenizedMessage> > Messages;
+    int32 NumAddCalls = 0;
+    int32 NumSetLabelCalls = 0;
+
+private:
+    FText Label;
+};
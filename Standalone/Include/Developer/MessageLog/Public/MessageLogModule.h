@@ -0,0 +1,33 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Modules/ModuleManager.h>
+#include <Developer/MessageLog/Public/IMessageLogListing.h>
+
+class FMessageLogModule : public IModuleInterface
+{
+public:
+    TSharedRef<IMessageLogListing> GetLogListing(const FName& LogName)
+    {
+        ++NumGetLogListingCalls;
+        if (TSharedRef<IMessageLogListing>* Existing = Listings.Find(LogName))
+        {
+            return *Existing;
+        }
+        return Listings.Add(LogName, MakeShared<IMessageLogListing>());
+    }
+
+    bool IsRegisteredLogListing(const FName& LogName) const { return Listings.Contains(LogName); }
+
+    void OpenMessageLog(const FName& LogName)
+    {
+        ++NumOpenMessageLogCalls;
+    }
+
+    int32 NumGetLogListingCalls = 0;
+    int32 NumOpenMessageLogCalls = 0;
+
+private:
+    TMap< FName, TSharedRef<IMessageLogListing> > Listings;
+};
@@ -0,0 +1,33 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+
+class UWorld;
+
+// Minimal engine that records on-screen debug messages instead of drawing them
+class UEngine
+{
+public:
+    struct FScreenMessage
+    {
+        uint64 Key;
+        float TimeToDisplay;
+        FColor DisplayColor;
+        FString Message;
+    };
+
+    void AddOnScreenDebugMessage(uint64 Key, float TimeToDisplay, FColor DisplayColor, const FString& DebugMessage, bool bNewerOnTop = true, const FVector2D& TextScale = FVector2D());
+    void AddOnScreenDebugMessage(int32 Key, float TimeToDisplay, FColor DisplayColor, const FString& DebugMessage, bool bNewerOnTop = true, const FVector2D& TextScale = FVector2D());
+
+    bool Exec(UWorld* InWorld, const TCHAR* Cmd) { return false; }
+    bool IsInitialized() const { return true; }
+
+    const TArray<FScreenMessage>& GetScreenMessages() const { return ScreenMessages; }
+    void ClearOnScreenDebugMessages() { ScreenMessages.Reset(); }
+
+private:
+    TArray<FScreenMessage> ScreenMessages;
+};
+
+extern UEngine* GEngine;
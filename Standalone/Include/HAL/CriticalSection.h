@@ -0,0 +1,16 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <mutex>
+
+// Recursive like the engine's platform critical sections
+class FCriticalSection
+{
+public:
+    void Lock() { Mutex.lock(); }
+    bool TryLock() { return Mutex.try_lock(); }
+    void Unlock() { Mutex.unlock(); }
+
+private:
+    std::recursive_mutex Mutex;
+};
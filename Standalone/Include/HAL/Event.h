@@ -0,0 +1,40 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+// Auto-reset event
+class FEvent
+{
+public:
+    void Trigger()
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        bTriggered = true;
+        Condition.notify_one();
+    }
+
+    void Reset()
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        bTriggered = false;
+    }
+
+    bool Wait(uint32 WaitTime = 0xffffffff)
+    {
+        std::unique_lock<std::mutex> Lock(Mutex);
+        const bool bSignaled = WaitTime == 0xffffffff
+            ? (Condition.wait(Lock, [this] { return bTriggered; }), true)
+            : Condition.wait_for(Lock, std::chrono::milliseconds(WaitTime), [this] { return bTriggered; });
+        bTriggered = false;
+        return bSignaled;
+    }
+
+private:
+    std::mutex Mutex;
+    std::condition_variable Condition;
+    bool bTriggered = false;
+};
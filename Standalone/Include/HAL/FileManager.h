@@ -0,0 +1,104 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+#include <cstdio>
+#include <sys/stat.h>
+
+enum EFileWrite
+{
+    FILEWRITE_None = 0x00,
+    FILEWRITE_NoFail = 0x01,
+    FILEWRITE_NoReplaceExisting = 0x02,
+    FILEWRITE_EvenIfReadOnly = 0x04,
+    FILEWRITE_Append = 0x08,
+    FILEWRITE_AllowRead = 0x10,
+    FILEWRITE_Silent = 0x20,
+};
+
+// Buffered by stdio, flushed by Flush and on close
+class FArchiveFileWriter : public FArchive
+{
+public:
+    explicit FArchiveFileWriter(std::FILE* InFile)
+        : File(InFile)
+    {}
+
+    virtual ~FArchiveFileWriter()
+    {
+        Close();
+    }
+
+    virtual void Serialize(void* V, int64 Length) override
+    {
+        if (File)
+        {
+            std::fwrite(V, 1, (size_t)Length, File);
+        }
+    }
+
+    virtual void Flush() override
+    {
+        if (File)
+        {
+            std::fflush(File);
+        }
+    }
+
+    virtual bool Close() override
+    {
+        const bool bSucceeded = !File || std::fclose(File) == 0;
+        File = nullptr;
+        return bSucceeded;
+    }
+
+private:
+    std::FILE* File;
+};
+
+class IFileManager
+{
+public:
+    static IFileManager& Get()
+    {
+        static IFileManager Manager;
+        return Manager;
+    }
+
+    bool FileExists(const TCHAR* Filename)
+    {
+        struct stat Info;
+        return stat(TCHAR_TO_UTF8(Filename), &Info) == 0 && S_ISREG(Info.st_mode);
+    }
+
+    bool MakeDirectory(const TCHAR* Path, bool bTree = false)
+    {
+        std::string Utf8 = TCHAR_TO_UTF8(Path);
+        for (size_t Index = 1; Index <= Utf8.size(); ++Index)
+        {
+            if (Index == Utf8.size() || Utf8[Index] == '/')
+            {
+                mkdir(Utf8.substr(0, Index).c_str(), 0755);
+            }
+        }
+        return true;
+    }
+
+    bool Move(const TCHAR* Dest, const TCHAR* Src, bool bReplace = true)
+    {
+        std::string DestUtf8 = TCHAR_TO_UTF8(Dest);
+        return std::rename(TCHAR_TO_UTF8(Src), DestUtf8.c_str()) == 0;
+    }
+
+    // Null if the file can't be opened, owned by the caller
+    FArchive* CreateFileWriter(const TCHAR* Filename, uint32 WriteFlags = 0)
+    {
+        std::FILE* File = std::fopen(TCHAR_TO_UTF8(Filename), (WriteFlags & FILEWRITE_Append) ? "ab" : "wb");
+        return File ? new FArchiveFileWriter(File) : nullptr;
+    }
+
+    bool Delete(const TCHAR* Filename)
+    {
+        return std::remove(TCHAR_TO_UTF8(Filename)) == 0;
+    }
+};
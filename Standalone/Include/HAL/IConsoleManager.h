@@ -0,0 +1,86 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+#include <map>
+
+// Minimal console: commands registered by FAutoConsoleCommand, run with IConsoleManager::ProcessUserConsoleInput
+class UWorld;
+
+struct FConsoleCommandWithWorldArgsAndOutputDeviceDelegate
+{
+    std::function<void(const TArray<FString>&, UWorld*, FOutputDevice&)> Function;
+
+    static FConsoleCommandWithWorldArgsAndOutputDeviceDelegate CreateStatic(void (*InFunction)(const TArray<FString>&, UWorld*, FOutputDevice&))
+    {
+        FConsoleCommandWithWorldArgsAndOutputDeviceDelegate Delegate;
+        Delegate.Function = InFunction;
+        return Delegate;
+    }
+
+    template<typename LambdaType>
+    static FConsoleCommandWithWorldArgsAndOutputDeviceDelegate CreateLambda(LambdaType Lambda)
+    {
+        FConsoleCommandWithWorldArgsAndOutputDeviceDelegate Delegate;
+        Delegate.Function = Lambda;
+        return Delegate;
+    }
+};
+
+class IConsoleManager
+{
+public:
+    static IConsoleManager& Get()
+    {
+        static IConsoleManager Manager;
+        return Manager;
+    }
+
+    void Register(const TCHAR* Name, const FConsoleCommandWithWorldArgsAndOutputDeviceDelegate& Delegate)
+    {
+        Commands[std::wstring(Name)] = Delegate;
+    }
+
+    bool ProcessUserConsoleInput(const TCHAR* Input, FOutputDevice& Ar, UWorld* InWorld)
+    {
+        TArray<FString> Tokens;
+        std::wstring Current;
+        for (const TCHAR* Char = Input; ; ++Char)
+        {
+            if (*Char == 0 || *Char == ' ')
+            {
+                if (!Current.empty()) { Tokens.Add(FString(Current.c_str())); Current.clear(); }
+                if (*Char == 0) { break; }
+            }
+            else
+            {
+                Current.push_back(*Char);
+            }
+        }
+        if (Tokens.Num() == 0) { return false; }
+
+        for (auto& Pair : Commands)
+        {
+            if (FString(Pair.first.c_str()).MatchesWildcard(Tokens[0]))
+            {
+                TArray<FString> Args;
+                for (int32 Index = 1; Index < Tokens.Num(); ++Index) { Args.Add(Tokens[Index]); }
+                Pair.second.Function(Args, InWorld, Ar);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::map<std::wstring, FConsoleCommandWithWorldArgsAndOutputDeviceDelegate> Commands;
+};
+
+class FAutoConsoleCommand
+{
+public:
+    FAutoConsoleCommand(const TCHAR* Name, const TCHAR* Help, const FConsoleCommandWithWorldArgsAndOutputDeviceDelegate& Command)
+    {
+        IConsoleManager::Get().Register(Name, Command);
+    }
+};
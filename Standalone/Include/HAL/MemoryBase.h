@@ -0,0 +1,22 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+#include <cstdlib>
+
+// Mirrors the engine allocator interface, GMalloc starts as a plain malloc wrapper
+class FMalloc
+{
+public:
+    virtual ~FMalloc() = default;
+    virtual void* Malloc(SIZE_T Count, uint32 Alignment = 0) = 0;
+    virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment = 0) = 0;
+    virtual void Free(void* Original) = 0;
+    virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) { return Count; }
+    virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) { return false; }
+    virtual void Trim(bool bTrimThreadCaches) {}
+    virtual bool IsInternallyThreadSafe() const { return false; }
+    virtual const TCHAR* GetDescriptiveName() { return TEXT("Unspecified allocator"); }
+};
+
+extern FMalloc* GMalloc;
@@ -0,0 +1,15 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <HAL/Event.h>
+#include <chrono>
+#include <thread>
+
+struct FPlatformProcess
+{
+    static bool SupportsMultithreading() { return true; }
+    static FEvent* GetSynchEventFromPool(bool bIsManualReset = false) { return new FEvent(); }
+    static void ReturnSynchEventToPool(FEvent* Event) { delete Event; }
+    static void Yield() { std::this_thread::yield(); }
+    static void Sleep(float Seconds) { std::this_thread::sleep_for(std::chrono::duration<float>(Seconds)); }
+};
@@ -0,0 +1,16 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+#include <atomic>
+
+struct FPlatformTLS
+{
+    // Small sequential ids, 0 is never handed out
+    static uint32 GetCurrentThreadId()
+    {
+        static std::atomic<uint32> NextId(1);
+        thread_local const uint32 Id = NextId.fetch_add(1);
+        return Id;
+    }
+};
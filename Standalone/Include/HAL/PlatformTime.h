@@ -0,0 +1,33 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+#include <chrono>
+
+struct FPlatformTime
+{
+    static double Seconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static uint64 Cycles64()
+    {
+        return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static double GetSecondsPerCycle64()
+    {
+        return 1e-9;
+    }
+
+    static uint32 Cycles()
+    {
+        return static_cast<uint32>(Cycles64());
+    }
+
+    static double GetSecondsPerCycle()
+    {
+        return 1e-9;
+    }
+};
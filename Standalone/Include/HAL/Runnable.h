@@ -0,0 +1,14 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+
+class FRunnable
+{
+public:
+    virtual ~FRunnable() = default;
+    virtual bool Init() { return true; }
+    virtual uint32 Run() = 0;
+    virtual void Stop() {}
+    virtual void Exit() {}
+};
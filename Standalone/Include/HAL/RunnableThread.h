@@ -0,0 +1,55 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <HAL/Runnable.h>
+#include <thread>
+
+enum EThreadPriority
+{
+    TPri_Normal,
+    TPri_AboveNormal,
+    TPri_BelowNormal,
+    TPri_Highest,
+    TPri_Lowest,
+};
+
+class FRunnableThread
+{
+public:
+    static FRunnableThread* Create(FRunnable* InRunnable, const TCHAR* ThreadName, uint32 InStackSize = 0, EThreadPriority InThreadPri = TPri_Normal)
+    {
+        return new FRunnableThread(InRunnable);
+    }
+
+    ~FRunnableThread()
+    {
+        WaitForCompletion();
+    }
+
+    void WaitForCompletion()
+    {
+        if (Thread.joinable())
+        {
+            Thread.join();
+        }
+    }
+
+    bool Kill(bool bShouldWait = true)
+    {
+        Runnable->Stop();
+        if (bShouldWait)
+        {
+            WaitForCompletion();
+        }
+        return true;
+    }
+
+private:
+    explicit FRunnableThread(FRunnable* InRunnable)
+        : Runnable(InRunnable)
+        , Thread([InRunnable]() { if (InRunnable->Init()) { InRunnable->Run(); } InRunnable->Exit(); })
+    {}
+
+    FRunnable* Runnable;
+    std::thread Thread;
+};
@@ -0,0 +1,34 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+
+namespace EMessageSeverity
+{
+    enum Type
+    {
+        Error = 1,
+        PerformanceWarning = 2,
+        Warning = 3,
+        Info = 4,
+    };
+}
+
+class FTokenizedMessage
+{
+public:
+    static TSharedRef<FTokenizedMessage> Create(EMessageSeverity::Type InSeverity, const FText& InMessageText = FText())
+    {
+        TSharedRef<FTokenizedMessage> Message = MakeShared<FTokenizedMessage>();
+        Message->Severity = InSeverity;
+        Message->Text = InMessageText;
+        return Message;
+    }
+
+    EMessageSeverity::Type GetSeverity() const { return Severity; }
+    FText ToText() const { return Text; }
+
+private:
+    EMessageSeverity::Type Severity = EMessageSeverity::Info;
+    FText Text;
+};
@@ -0,0 +1,79 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+class FDelegateHandle
+{
+public:
+    FDelegateHandle() = default;
+    explicit FDelegateHandle(uint64 InId) : Id(InId) {}
+    bool IsValid() const { return Id != 0; }
+    bool operator==(const FDelegateHandle& Other) const { return Id == Other.Id; }
+
+private:
+    uint64 Id = 0;
+};
+
+class FSimpleMulticastDelegate
+{
+public:
+    template<typename UserClass>
+    FDelegateHandle AddRaw(UserClass* Object, void (UserClass::*Method)())
+    {
+        return AddLambda([Object, Method]() { (Object->*Method)(); });
+    }
+
+    template<typename FunctorType>
+    FDelegateHandle AddLambda(FunctorType&& Functor)
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        const FDelegateHandle Handle(++LastId);
+        Bindings.emplace_back(Handle, std::function<void()>(Forward<FunctorType>(Functor)));
+        return Handle;
+    }
+
+    bool Remove(FDelegateHandle Handle)
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        for (auto It = Bindings.begin(); It != Bindings.end(); ++It)
+        {
+            if (It->first == Handle)
+            {
+                Bindings.erase(It);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Broadcast()
+    {
+        std::vector<std::pair<FDelegateHandle, std::function<void()>>> Copy;
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            Copy = Bindings;
+        }
+        for (auto& Binding : Copy)
+        {
+            Binding.second();
+        }
+    }
+
+private:
+    std::mutex Mutex;
+    uint64 LastId = 0;
+    std::vector<std::pair<FDelegateHandle, std::function<void()>>> Bindings;
+};
+
+struct FCoreDelegates
+{
+    static FSimpleMulticastDelegate OnPreExit;
+    static FSimpleMulticastDelegate OnExit;
+    static FSimpleMulticastDelegate OnEndFrame;
+    static FSimpleMulticastDelegate OnHandleSystemError;
+    static FSimpleMulticastDelegate OnShutdownAfterError;
+};
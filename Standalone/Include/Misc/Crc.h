@@ -0,0 +1,23 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+
+struct FCrc
+{
+    // Plain CRC-32, only stands in for the engine's table driven implementation
+    static uint32 MemCrc32(const void* Data, int32 Length, uint32 CRC = 0)
+    {
+        const uint8* Bytes = static_cast<const uint8*>(Data);
+        CRC = ~CRC;
+        for (int32 Index = 0; Index < Length; ++Index)
+        {
+            CRC ^= Bytes[Index];
+            for (int32 Bit = 0; Bit < 8; ++Bit)
+            {
+                CRC = (CRC >> 1) ^ (0xEDB88320u & (0u - (CRC & 1u)));
+            }
+        }
+        return ~CRC;
+    }
+};
@@ -0,0 +1,23 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+#include <chrono>
+
+struct FDateTime
+{
+    explicit FDateTime(int64 InTicks = 0) : Ticks(InTicks) {}
+
+    // Ticks are 100 nanoseconds since 0001-01-01 like the engine
+    static FDateTime UtcNow()
+    {
+        constexpr int64 UnixEpochTicks = 621355968000000000LL;
+        const int64 SinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count() / 100;
+        return FDateTime(UnixEpochTicks + SinceEpoch);
+    }
+
+    int64 GetTicks() const { return Ticks; }
+
+private:
+    int64 Ticks;
+};
@@ -0,0 +1,6 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+// Everything Unlog needs from this header already lives in the CoreMinimal.h stand-in
+
+#include <CoreMinimal.h>
@@ -0,0 +1,21 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+
+struct FPaths
+{
+    // Relative to the working directory, like an engine running from its project folder
+    static FString ProjectSavedDir() { return FString(TEXT("Saved/")); }
+    static FString ProjectLogDir() { return FString(TEXT("Saved/Logs/")); }
+
+    static FString Combine(const FString& A, const FString& B)
+    {
+        if (A.IsEmpty())
+        {
+            return B;
+        }
+        const TCHAR Last = (*A)[A.Len() - 1];
+        return (Last == TEXT('/') || Last == TEXT('\\')) ? A + B : A + TEXT("/") + B;
+    }
+};
@@ -0,0 +1,17 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <HAL/CriticalSection.h>
+
+class FScopeLock
+{
+public:
+    explicit FScopeLock(FCriticalSection* InSynchObject) : SynchObject(InSynchObject) { SynchObject->Lock(); }
+    ~FScopeLock() { SynchObject->Unlock(); }
+
+    FScopeLock(const FScopeLock&) = delete;
+    FScopeLock& operator=(const FScopeLock&) = delete;
+
+private:
+    FCriticalSection* SynchObject;
+};
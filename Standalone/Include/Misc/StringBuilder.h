@@ -0,0 +1,158 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Containers/StringView.h>
+
+/**
+* String builder writing into an externally provided buffer, only moving to the heap
+* once the buffer is full. Mirrors the engine's TStringBuilderBase closely enough
+* for heap usage to be representative.
+*/
+template<typename CharType>
+class TStringBuilderBase
+{
+public:
+    TStringBuilderBase(const TStringBuilderBase&) = delete;
+    TStringBuilderBase& operator=(const TStringBuilderBase&) = delete;
+
+    ~TStringBuilderBase()
+    {
+        if (Base != InlineBuffer)
+        {
+            delete[] Base;
+        }
+    }
+
+    int32 Len() const { return static_cast<int32>(Cursor - Base); }
+    const CharType* GetData() const { return Base; }
+
+    const CharType* ToString() const
+    {
+        *Cursor = CharType(0);
+        return Base;
+    }
+
+    TStringView<CharType> ToView() const { return TStringView<CharType>(Base, Len()); }
+
+    void Reset() { Cursor = Base; }
+
+    TStringBuilderBase& AppendChar(CharType Char)
+    {
+        EnsureAdditionalCapacity(1);
+        *Cursor++ = Char;
+        return *this;
+    }
+
+    TStringBuilderBase& Append(const CharType* String, int32 Length)
+    {
+        EnsureAdditionalCapacity(Length);
+        std::char_traits<CharType>::copy(Cursor, String, Length);
+        Cursor += Length;
+        return *this;
+    }
+
+    TStringBuilderBase& Append(const CharType* String)
+    {
+        return Append(String, TCString<CharType>::Strlen(String));
+    }
+
+    TStringBuilderBase& Append(TStringView<CharType> View)
+    {
+        return Append(View.GetData(), View.Len());
+    }
+
+    template<typename... ArgTypes>
+    TStringBuilderBase& Appendf(const CharType* Fmt, ArgTypes... Args)
+    {
+        return AppendfImpl(*this, Fmt, Args...);
+    }
+
+    static TStringBuilderBase& AppendfImpl(TStringBuilderBase& Self, const CharType* Fmt, ...);
+
+    TStringBuilderBase& operator<<(const CharType* String) { return Append(String); }
+    TStringBuilderBase& operator<<(TStringView<CharType> View) { return Append(View); }
+    TStringBuilderBase& operator<<(CharType Char) { return AppendChar(Char); }
+
+protected:
+    TStringBuilderBase(CharType* InBuffer, int32 InCapacity)
+        : Base(InBuffer)
+        , Cursor(InBuffer)
+        , End(InBuffer + InCapacity)
+        , InlineBuffer(InBuffer)
+    {}
+
+    void EnsureAdditionalCapacity(int32 Num)
+    {
+        // One extra character is always kept around for the null terminator
+        if (Cursor + Num + 1 > End)
+        {
+            Extend(Num);
+        }
+    }
+
+    void Extend(int32 Num)
+    {
+        const int32 OldLength = Len();
+        const int32 NewCapacity = std::max<int32>(static_cast<int32>(End - Base) * 2, OldLength + Num + 1);
+
+        CharType* NewBase = new CharType[NewCapacity];
+        std::char_traits<CharType>::copy(NewBase, Base, OldLength);
+        if (Base != InlineBuffer)
+        {
+            delete[] Base;
+        }
+
+        Base = NewBase;
+        Cursor = NewBase + OldLength;
+        End = NewBase + NewCapacity;
+    }
+
+    CharType* Base;
+    CharType* Cursor;
+    CharType* End;
+    CharType* InlineBuffer;
+};
+
+template<>
+inline TStringBuilderBase<TCHAR>& TStringBuilderBase<TCHAR>::AppendfImpl(TStringBuilderBase& Self, const TCHAR* Fmt, ...)
+{
+    // Formats on the stack first like the engine does, only short messages avoid the heap
+    TCHAR Buffer[512];
+    va_list Args;
+    va_start(Args, Fmt);
+    const int32 Written = FCString::GetVarArgs(Buffer, UE_ARRAY_COUNT(Buffer), Fmt, Args);
+    va_end(Args);
+    if (Written >= 0)
+    {
+        return Self.Append(Buffer, Written);
+    }
+
+    va_start(Args, Fmt);
+    const FString Formatted = FString::VPrintf(Fmt, Args);
+    va_end(Args);
+    return Self.Append(*Formatted, Formatted.Len());
+}
+
+template<typename CharType, int32 BufferSize>
+class TStringBuilderWithBuffer : public TStringBuilderBase<CharType>
+{
+public:
+    TStringBuilderWithBuffer()
+        : TStringBuilderBase<CharType>(StringBuffer, BufferSize)
+    {}
+
+private:
+    CharType StringBuffer[BufferSize];
+};
+
+inline void FName::AppendString(FStringBuilderBase& Out) const
+{
+    if (Entry)
+    {
+        Out.Append(**Entry, Entry->Len());
+    }
+}
+
+template<int32 BufferSize>
+using TStringBuilder = TStringBuilderWithBuffer<TCHAR, BufferSize>;
@@ -0,0 +1,39 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+
+class IModuleInterface
+{
+public:
+    virtual ~IModuleInterface() = default;
+};
+
+class FModuleManager
+{
+public:
+    static FModuleManager& Get()
+    {
+        static FModuleManager Manager;
+        return Manager;
+    }
+
+    // Every module type is a lazily created singleton
+    template<typename TModuleInterface>
+    static TModuleInterface& LoadModuleChecked(const FName ModuleName)
+    {
+        static TModuleInterface Module;
+        ++Get().NumLoadModuleCalls;
+        return Module;
+    }
+
+    template<typename TModuleInterface>
+    static TModuleInterface& GetModuleChecked(const FName ModuleName)
+    {
+        return LoadModuleChecked<TModuleInterface>(ModuleName);
+    }
+
+    bool IsModuleLoaded(const FName ModuleName) const { return true; }
+
+    int32 NumLoadModuleCalls = 0;
+};
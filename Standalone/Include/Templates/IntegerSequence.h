@@ -0,0 +1,10 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <utility>
+
+template <typename T, T... Indices>
+using TIntegerSequence = std::integer_sequence<T, Indices...>;
+
+template <typename T, T N>
+using TMakeIntegerSequence = std::make_integer_sequence<T, N>;
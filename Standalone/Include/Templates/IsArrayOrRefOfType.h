@@ -0,0 +1,11 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+
+template<typename T, typename ArrType>
+struct TIsArrayOrRefOfType
+{
+    static constexpr bool Value = std::is_same<typename std::remove_cv<typename std::remove_extent<typename std::remove_reference<T>::type>::type>::type, ArrType>::value
+        && std::is_array<typename std::remove_reference<T>::type>::value;
+};
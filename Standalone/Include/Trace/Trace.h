@@ -0,0 +1,195 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <CoreMinimal.h>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Minimal trace: same macros as the engine, events are copied into a per thread buffer and dropped.
+// Channels start off, toggle them with UE::Trace::ToggleChannel
+#ifndef UE_TRACE_ENABLED
+#define UE_TRACE_ENABLED 1
+#endif
+
+namespace UE
+{
+namespace Trace
+{
+    // Field types for strings
+    struct AnsiString {};
+    struct WideString {};
+
+    class FChannel;
+
+    inline std::vector<FChannel*>& GetChannels()
+    {
+        static std::vector<FChannel*> Channels;
+        return Channels;
+    }
+
+    class FChannel
+    {
+    public:
+        // Named after the variable without its Channel suffix, like in the engine
+        explicit FChannel(const ANSICHAR* VariableName)
+            : Name(VariableName, std::strlen(VariableName) - (std::strstr(VariableName, "Channel") ? 7 : 0))
+            , bEnabled(false)
+        {
+            GetChannels().push_back(this);
+        }
+
+        ~FChannel()
+        {
+            std::vector<FChannel*>& Channels = GetChannels();
+            for (size_t Index = 0; Index < Channels.size(); ++Index)
+            {
+                if (Channels[Index] == this)
+                {
+                    Channels.erase(Channels.begin() + Index);
+                    break;
+                }
+            }
+        }
+
+        explicit operator bool() const
+        {
+            return bEnabled.load(std::memory_order_relaxed);
+        }
+
+        const std::string& GetName() const
+        {
+            return Name;
+        }
+
+        void Toggle(bool bInEnabled)
+        {
+            bEnabled.store(bInEnabled, std::memory_order_relaxed);
+        }
+
+    private:
+        std::string Name;
+        std::atomic<bool> bEnabled;
+    };
+
+    // Toggles every channel with that name, returns whether there was any
+    inline bool ToggleChannel(const TCHAR* ChannelName, bool bEnabled)
+    {
+        const std::string Name = TCHAR_TO_UTF8(ChannelName);
+
+        bool bFound = false;
+        for (FChannel* Channel : GetChannels())
+        {
+            if (Channel->GetName() == Name)
+            {
+                Channel->Toggle(bEnabled);
+                bFound = true;
+            }
+        }
+        return bFound;
+    }
+
+    struct FFieldValue
+    {
+        const void* Data;
+        int32 Size;
+    };
+
+    template< typename T >
+    struct TField
+    {
+        FFieldValue operator()(const T& Value) const
+        {
+            return FFieldValue{ &Value, (int32)sizeof(T) };
+        }
+    };
+
+    template< typename T >
+    struct TField<T[]>
+    {
+        FFieldValue operator()(const T* Data, int32 Num) const
+        {
+            return FFieldValue{ Data, Num * (int32)sizeof(T) };
+        }
+    };
+
+    template<>
+    struct TField<AnsiString>
+    {
+        FFieldValue operator()(const ANSICHAR* String, int32 Length = -1) const
+        {
+            return FFieldValue{ String, Length < 0 ? (int32)std::strlen(String) : Length };
+        }
+    };
+
+    template<>
+    struct TField<WideString>
+    {
+        FFieldValue operator()(const TCHAR* String, int32 Length = -1) const
+        {
+            return FFieldValue{ String, (Length < 0 ? FCString::Strlen(String) : Length) * (int32)sizeof(TCHAR) };
+        }
+    };
+
+    // Copies the fields of one event into the calling thread's buffer
+    class FEventWriter
+    {
+    public:
+        static constexpr int32 BufferSize = 4096;
+
+        explicit FEventWriter(const ANSICHAR* InEventName)
+            : Size(0)
+        {}
+
+        FEventWriter& operator<<(const FFieldValue& Field)
+        {
+            const int32 Copied = FMath::Min(Field.Size, BufferSize - Size);
+            if (Copied > 0)
+            {
+                std::memcpy(GetBuffer() + Size, Field.Data, Copied);
+                Size += Copied;
+            }
+            return *this;
+        }
+
+    private:
+        static uint8* GetBuffer()
+        {
+            thread_local uint8 Buffer[BufferSize];
+            return Buffer;
+        }
+
+        int32 Size;
+    };
+}
+}
+
+#define UE_TRACE_CHANNEL(ChannelName, ...) static UE::Trace::FChannel ChannelName(#ChannelName);
+
+// Shared by every translation unit, defined once with UE_TRACE_CHANNEL_DEFINE
+#define UE_TRACE_CHANNEL_EXTERN(ChannelName, ...) extern UE::Trace::FChannel& ChannelName;
+#define UE_TRACE_CHANNEL_DEFINE(ChannelName, ...) \
+    UE::Trace::FChannel ChannelName##Object(#ChannelName); \
+    UE::Trace::FChannel& ChannelName = ChannelName##Object;
+
+#define UE_TRACE_CHANNELEXPR_IS_ENABLED(ChannelsExpr) bool(ChannelsExpr)
+
+#define UE_TRACE_EVENT_BEGIN(LoggerName, EventName, ...) \
+    struct F##LoggerName##EventName##Fields \
+    { \
+        static const ANSICHAR* GetName() { return #LoggerName "." #EventName; } \
+        explicit operator bool() const { return true; }
+
+// Events don't hold any state here, the extern variants only exist to mirror the engine's
+#define UE_TRACE_EVENT_BEGIN_EXTERN(LoggerName, EventName, ...) UE_TRACE_EVENT_BEGIN(LoggerName, EventName, ##__VA_ARGS__)
+#define UE_TRACE_EVENT_DEFINE(LoggerName, EventName)
+
+#define UE_TRACE_EVENT_FIELD(FieldType, FieldName) UE::Trace::TField<FieldType> FieldName;
+
+#define UE_TRACE_EVENT_END() };
+
+#define UE_TRACE_LOG(LoggerName, EventName, ChannelsExpr, ...) \
+    if (UE_TRACE_CHANNELEXPR_IS_ENABLED(ChannelsExpr)) \
+        if (const auto& EventName = F##LoggerName##EventName##Fields()) \
+            UE::Trace::FEventWriter(F##LoggerName##EventName##Fields::GetName())
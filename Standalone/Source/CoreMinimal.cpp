@@ -0,0 +1,471 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+
+#include <CoreMinimal.h>
+
+const TCHAR* ToString(ELogVerbosity::Type Verbosity)
+{
+    switch (Verbosity & ELogVerbosity::VerbosityMask)
+    {
+    case ELogVerbosity::NoLogging:
+        return TEXT("NoLogging");
+    case ELogVerbosity::Fatal:
+        return TEXT("Fatal");
+    case ELogVerbosity::Error:
+        return TEXT("Error");
+    case ELogVerbosity::Warning:
+        return TEXT("Warning");
+    case ELogVerbosity::Display:
+        return TEXT("Display");
+    case ELogVerbosity::Log:
+        return TEXT("Log");
+    case ELogVerbosity::Verbose:
+        return TEXT("Verbose");
+    case ELogVerbosity::VeryVerbose:
+        return TEXT("VeryVerbose");
+    }
+    return TEXT("Unknown");
+}
+
+// ------------------------------------------------------------------------------------
+// FString
+// ------------------------------------------------------------------------------------
+
+namespace
+{
+    // Decodes UTF-8, which is a superset of the ANSI inputs the engine accepts
+    template<typename OutputType>
+    void DecodeUtf8(const ANSICHAR* Str, OutputType&& Output)
+    {
+        const unsigned char* Cursor = reinterpret_cast<const unsigned char*>(Str ? Str : "");
+        while (*Cursor)
+        {
+            uint32 CodePoint = *Cursor++;
+            int32 Extra = 0;
+
+            if (CodePoint >= 0xF0) { CodePoint &= 0x07; Extra = 3; }
+            else if (CodePoint >= 0xE0) { CodePoint &= 0x0F; Extra = 2; }
+            else if (CodePoint >= 0xC0) { CodePoint &= 0x1F; Extra = 1; }
+
+            for (; Extra > 0 && (*Cursor & 0xC0) == 0x80; --Extra)
+            {
+                CodePoint = (CodePoint << 6) | (*Cursor++ & 0x3F);
+            }
+
+            Output(static_cast<TCHAR>(CodePoint));
+        }
+    }
+}
+
+FString::FString(const ANSICHAR* Str)
+{
+    DecodeUtf8(Str, [this](TCHAR Char) { Data.push_back(Char); });
+}
+
+FString FString::PrintfImpl(const TCHAR* Fmt, ...)
+{
+    va_list Args;
+    va_start(Args, Fmt);
+    FString Result = VPrintf(Fmt, Args);
+    va_end(Args);
+    return Result;
+}
+
+namespace
+{
+    // The engine treats %s and %c as TCHAR arguments, the C runtime needs the 'l' modifier for that
+    void ConvertFormat(const TCHAR* Fmt, std::wstring& WideFormat)
+    {
+        WideFormat.clear();
+        for (const TCHAR* Cursor = Fmt; *Cursor; ++Cursor)
+        {
+            WideFormat.push_back(*Cursor);
+            if (*Cursor != TEXT('%'))
+            {
+                continue;
+            }
+
+            ++Cursor;
+            while (*Cursor && std::wcschr(TEXT("-+ #0123456789.*"), *Cursor))
+            {
+                WideFormat.push_back(*Cursor++);
+            }
+
+            if (*Cursor == TEXT('s') || *Cursor == TEXT('c'))
+            {
+                WideFormat.push_back(TEXT('l'));
+            }
+
+            if (!*Cursor)
+            {
+                break;
+            }
+            WideFormat.push_back(*Cursor);
+        }
+    }
+}
+
+template<>
+int32 TCString<TCHAR>::GetVarArgs(TCHAR* Dest, SIZE_T DestSize, const TCHAR*& Fmt, va_list ArgPtr)
+{
+    // Reused per thread so formatting doesn't allocate once warmed up
+    thread_local std::wstring WideFormat;
+    ConvertFormat(Fmt, WideFormat);
+
+    const int Written = std::vswprintf(Dest, DestSize, WideFormat.c_str(), ArgPtr);
+    return Written >= 0 && static_cast<SIZE_T>(Written) < DestSize ? Written : -1;
+}
+
+FString FString::VPrintf(const TCHAR* Fmt, va_list Args)
+{
+    std::vector<TCHAR> Buffer(256);
+    for (;;)
+    {
+        va_list ArgsCopy;
+        va_copy(ArgsCopy, Args);
+        const int32 Written = FCString::GetVarArgs(Buffer.data(), Buffer.size(), Fmt, ArgsCopy);
+        va_end(ArgsCopy);
+
+        if (Written >= 0)
+        {
+            return FString(Written, Buffer.data());
+        }
+        Buffer.resize(Buffer.size() * 4);
+    }
+}
+
+FString FString::Format(const TCHAR* InFormatString, const FStringFormatOrderedArguments& InOrderedArguments)
+{
+    FString Result;
+    const TCHAR* Cursor = InFormatString;
+
+    while (*Cursor)
+    {
+        if (*Cursor == TEXT('{'))
+        {
+            const TCHAR* TokenEnd = Cursor + 1;
+            int64 Index = 0;
+            while (*TokenEnd >= TEXT('0') && *TokenEnd <= TEXT('9'))
+            {
+                Index = Index * 10 + (*TokenEnd - TEXT('0'));
+                ++TokenEnd;
+            }
+
+            if (TokenEnd != Cursor + 1 && *TokenEnd == TEXT('}') && Index < InOrderedArguments.Num())
+            {
+                AppendToString(InOrderedArguments[static_cast<int32>(Index)], Result);
+                Cursor = TokenEnd + 1;
+                continue;
+            }
+        }
+
+        Result.AppendChar(*Cursor++);
+    }
+
+    return Result;
+}
+
+FString LexToStringImpl(int64 Value)
+{
+    return FString::Printf(TEXT("%lld"), static_cast<long long>(Value));
+}
+
+FString LexToStringImpl(uint64 Value)
+{
+    return FString::Printf(TEXT("%llu"), static_cast<unsigned long long>(Value));
+}
+
+FString LexToStringImpl(double Value)
+{
+    return FString::Printf(TEXT("%f"), Value);
+}
+
+void AppendToString(const FStringFormatArg& Arg, FString& StringToAppendTo)
+{
+    switch (Arg.Type)
+    {
+    case FStringFormatArg::Int:
+        StringToAppendTo += LexToString(Arg.IntValue);
+        break;
+    case FStringFormatArg::UInt:
+        StringToAppendTo += LexToString(Arg.UIntValue);
+        break;
+    case FStringFormatArg::Double:
+        StringToAppendTo += LexToString(Arg.DoubleValue);
+        break;
+    case FStringFormatArg::String:
+        StringToAppendTo += Arg.StringValue;
+        break;
+    case FStringFormatArg::StringLiteral:
+        StringToAppendTo += Arg.StringLiteralValue;
+        break;
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// Names
+// ------------------------------------------------------------------------------------
+
+#include <mutex>
+#include <unordered_map>
+
+const FString* FName::FindOrAdd(const FString& Name)
+{
+    if (Name.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    static std::mutex Mutex;
+    static std::unordered_map<std::wstring, FString>* Entries = new std::unordered_map<std::wstring, FString>();
+
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto It = Entries->find(*Name);
+    if (It == Entries->end())
+    {
+        It = Entries->emplace(*Name, Name).first;
+    }
+    return &It->second;
+}
+
+// ------------------------------------------------------------------------------------
+// Output devices
+// ------------------------------------------------------------------------------------
+
+void FOutputDeviceRedirector::Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category)
+{
+    if (OutputDevices.Num() == 0)
+    {
+        const ELogVerbosity::Type Level = static_cast<ELogVerbosity::Type>(Verbosity & ELogVerbosity::VerbosityMask);
+        if (Level == ELogVerbosity::Log)
+        {
+            std::printf("%ls: %ls\n", *Category.ToString(), V);
+        }
+        else
+        {
+            std::printf("%ls: %ls: %ls\n", *Category.ToString(), ToString(Level), V);
+        }
+        return;
+    }
+
+    for (FOutputDevice* OutputDevice : OutputDevices)
+    {
+        OutputDevice->Serialize(V, Verbosity, Category);
+    }
+}
+
+void FOutputDeviceRedirector::Flush()
+{
+    for (FOutputDevice* OutputDevice : OutputDevices)
+    {
+        OutputDevice->Flush();
+    }
+    std::fflush(stdout);
+}
+
+void FOutputDeviceRedirector::AddOutputDevice(FOutputDevice* OutputDevice)
+{
+    OutputDevices.Add(OutputDevice);
+}
+
+void FOutputDeviceRedirector::RemoveOutputDevice(FOutputDevice* OutputDevice)
+{
+    for (int32 Index = 0; Index < OutputDevices.Num(); ++Index)
+    {
+        if (OutputDevices[Index] == OutputDevice)
+        {
+            OutputDevices.RemoveAt(Index);
+            return;
+        }
+    }
+}
+
+FOutputDeviceRedirector* FOutputDeviceRedirector::Get()
+{
+    static FOutputDeviceRedirector Singleton;
+    return &Singleton;
+}
+
+void FMsg::LogfImpl(const ANSICHAR* File, int32 Line, const FName& Category, ELogVerbosity::Type Verbosity, const TCHAR* Fmt, ...)
+{
+    va_list Args;
+    va_start(Args, Fmt);
+    const FString Message = FString::VPrintf(Fmt, Args);
+    va_end(Args);
+
+    GLog->Serialize(*Message, Verbosity, Category);
+}
+
+// ------------------------------------------------------------------------------------
+// Math
+// ------------------------------------------------------------------------------------
+
+const FColor FColor::White(255, 255, 255);
+const FColor FColor::Black(0, 0, 0);
+const FColor FColor::Red(255, 0, 0);
+const FColor FColor::Green(0, 255, 0);
+const FColor FColor::Blue(0, 0, 255);
+const FColor FColor::Yellow(255, 255, 0);
+const FColor FColor::Cyan(0, 255, 255);
+const FColor FColor::Magenta(255, 0, 255);
+const FColor FColor::Orange(243, 156, 18);
+
+// ------------------------------------------------------------------------------------
+// Engine
+// ------------------------------------------------------------------------------------
+
+void UEngine::AddOnScreenDebugMessage(uint64 Key, float TimeToDisplay, FColor DisplayColor, const FString& DebugMessage, bool bNewerOnTop, const FVector2D& TextScale)
+{
+    // Keyed messages replace their previous entry just like the engine does
+    if (Key != static_cast<uint64>(INDEX_NONE))
+    {
+        FScreenMessage* Existing = ScreenMessages.FindByPredicate([Key](const FScreenMessage& Message) { return Message.Key == Key; });
+        if (Existing)
+        {
+            Existing->TimeToDisplay = TimeToDisplay;
+            Existing->DisplayColor = DisplayColor;
+            Existing->Message = DebugMessage;
+            return;
+        }
+    }
+
+    ScreenMessages.Add(FScreenMessage{ Key, TimeToDisplay, DisplayColor, DebugMessage });
+}
+
+void UEngine::AddOnScreenDebugMessage(int32 Key, float TimeToDisplay, FColor DisplayColor, const FString& DebugMessage, bool bNewerOnTop, const FVector2D& TextScale)
+{
+    AddOnScreenDebugMessage(static_cast<uint64>(static_cast<int64>(Key)), TimeToDisplay, DisplayColor, DebugMessage, bNewerOnTop, TextScale);
+}
+
+static UEngine GStandaloneEngine;
+UEngine* GEngine = &GStandaloneEngine;
+
+#include <Misc/CoreDelegates.h>
+#include <HAL/PlatformTLS.h>
+
+FSimpleMulticastDelegate FCoreDelegates::OnPreExit;
+FSimpleMulticastDelegate FCoreDelegates::OnExit;
+FSimpleMulticastDelegate FCoreDelegates::OnHandleSystemError;
+FSimpleMulticastDelegate FCoreDelegates::OnShutdownAfterError;
+FSimpleMulticastDelegate FCoreDelegates::OnEndFrame;
+FFeedbackContext* GWarn = nullptr;
+
+static const uint32 GGameThreadId = FPlatformTLS::GetCurrentThreadId();
+
+bool IsInGameThread()
+{
+    return FPlatformTLS::GetCurrentThreadId() == GGameThreadId;
+}
+
+FUTF8ToTCHAR::FUTF8ToTCHAR(const ANSICHAR* Source)
+    : Len(0)
+{
+    DecodeUtf8(Source, [this](TCHAR Char)
+    {
+        // Moves to the heap once the inline buffer can't hold the terminator anymore
+        if (Len + 1 < InlineSize)
+        {
+            Inline[Len] = Char;
+        }
+        else
+        {
+            if (Overflow.empty())
+            {
+                Overflow.assign(Inline, Len);
+            }
+            Overflow.push_back(Char);
+        }
+        ++Len;
+    });
+
+    if (Overflow.empty())
+    {
+        Inline[Len] = TEXT('\0');
+    }
+}
+
+FTCHARToUTF8::FTCHARToUTF8(const TCHAR* Source)
+{
+    for (; Source && *Source; ++Source)
+    {
+        const uint32 Code = static_cast<uint32>(*Source);
+        if (Code < 0x80)
+        {
+            Converted.push_back(static_cast<char>(Code));
+        }
+        else if (Code < 0x800)
+        {
+            Converted.push_back(static_cast<char>(0xC0 | (Code >> 6)));
+            Converted.push_back(static_cast<char>(0x80 | (Code & 0x3F)));
+        }
+        else if (Code < 0x10000)
+        {
+            Converted.push_back(static_cast<char>(0xE0 | (Code >> 12)));
+            Converted.push_back(static_cast<char>(0x80 | ((Code >> 6) & 0x3F)));
+            Converted.push_back(static_cast<char>(0x80 | (Code & 0x3F)));
+        }
+        else
+        {
+            Converted.push_back(static_cast<char>(0xF0 | (Code >> 18)));
+            Converted.push_back(static_cast<char>(0x80 | ((Code >> 12) & 0x3F)));
+            Converted.push_back(static_cast<char>(0x80 | ((Code >> 6) & 0x3F)));
+            Converted.push_back(static_cast<char>(0x80 | (Code & 0x3F)));
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// Memory, global new and delete go through GMalloc like they do in the engine
+// ------------------------------------------------------------------------------------
+
+#include <HAL/MemoryBase.h>
+#include <new>
+
+namespace
+{
+    class FMallocAnsi : public FMalloc
+    {
+    public:
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            void* Result = nullptr;
+            return posix_memalign(&Result, FMath::Max<SIZE_T>(Alignment, sizeof(void*)), Count ? Count : 1) == 0 ? Result : nullptr;
+        }
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override { return std::realloc(Original, Count); }
+        // Not inlined into operator delete, where gcc would flag the free as mismatched with new
+        virtual FORCENOINLINE void Free(void* Original) override { std::free(Original); }
+        virtual bool IsInternallyThreadSafe() const override { return true; }
+        virtual const TCHAR* GetDescriptiveName() override { return TEXT("ANSI"); }
+    };
+
+    FMalloc* GetMalloc();
+}
+
+FMalloc* GMalloc = nullptr;
+
+namespace
+{
+    FMalloc* GetMalloc()
+    {
+        // Never destroyed, statics may still free memory after it would have been
+        if (!GMalloc)
+        {
+            alignas(FMallocAnsi) static uint8 Storage[sizeof(FMallocAnsi)];
+            GMalloc = new (Storage) FMallocAnsi();
+        }
+        return GMalloc;
+    }
+}
+
+void* operator new(std::size_t Count) { return GetMalloc()->Malloc(Count, 0); }
+void* operator new[](std::size_t Count) { return GetMalloc()->Malloc(Count, 0); }
+void* operator new(std::size_t Count, const std::nothrow_t&) noexcept { return GetMalloc()->Malloc(Count, 0); }
+void* operator new[](std::size_t Count, const std::nothrow_t&) noexcept { return GetMalloc()->Malloc(Count, 0); }
+void operator delete(void* Original) noexcept { GetMalloc()->Free(Original); }
+void operator delete[](void* Original) noexcept { GetMalloc()->Free(Original); }
+void operator delete(void* Original, std::size_t) noexcept { GetMalloc()->Free(Original); }
+void operator delete[](void* Original, std::size_t) noexcept { GetMalloc()->Free(Original); }
+void operator delete(void* Original, const std::nothrow_t&) noexcept { GetMalloc()->Free(Original); }
+void operator delete[](void* Original, const std::nothrow_t&) noexcept { GetMalloc()->Free(Original); }
+
+void* FMemory::Malloc(SIZE_T Count, uint32 Alignment) { return GetMalloc()->Malloc(Count, Alignment); }
+void FMemory::Free(void* Original) { GetMalloc()->Free(Original); }
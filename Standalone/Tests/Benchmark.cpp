@@ -0,0 +1,14 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+
+#include <Extras/Benchmark.h>
+#include <cstdlib>
+
+// Usage: UnlogBenchmark [Iterations]
+UNLOG_TRACE_DEFINE()
+
+int main(int argc, char** argv)
+{
+    const int32 Iterations = argc > 1 ? std::atoi(argv[1]) : 100000;
+    UnlogBenchmark::Run(*GLog, FMath::Max(Iterations, 1));
+    return 0;
+}
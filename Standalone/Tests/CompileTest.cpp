@@ -0,0 +1,15 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+
+#include <Unlog.h>
+#include <Target/MessageLog.h>
+#include <Target/BinaryRingFile.h>
+#include <Extras/Testing.h>
+
+UNLOG_TRACE_DEFINE()
+
+int main()
+{
+    UnlogTesting::CompileTest();
+    TUnlog<>::Flush();
+    return 0;
+}
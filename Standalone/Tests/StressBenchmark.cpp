@@ -0,0 +1,15 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+
+#include <Extras/Benchmark.h>
+#include <cstdlib>
+
+// Usage: UnlogStressBenchmark [Threads] [Seconds]
+UNLOG_TRACE_DEFINE()
+
+int main(int argc, char** argv)
+{
+    const int32 NumThreads = argc > 1 ? std::atoi(argv[1]) : 8;
+    const double Seconds = argc > 2 ? std::atof(argv[2]) : 5.0;
+    UnlogBenchmark::RunStress(*GLog, FMath::Max(NumThreads, 1), Seconds);
+    return 0;
+}
@@ -0,0 +1,11 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+
+#include <Unlog.h>
+#include <Extras/Testing.h>
+
+UNLOG_TRACE_DEFINE()
+
+int main()
+{
+    return UnlogTesting::RunTests(*GLog) == 0 ? 0 : 1;
+}
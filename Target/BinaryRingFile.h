@@ -0,0 +1,449 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <HAL/FileManager.h>
+#include <Misc/Paths.h>
+#include <Misc/DateTime.h>
+
+#if PLATFORM_WINDOWS
+#include <Windows/AllowWindowsPlatformTypes.h>
+#include <windows.h>
+#include <Windows/HideWindowsPlatformTypes.h>
+#elif PLATFORM_UNIX || PLATFORM_MAC
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// File written by Target::BinaryRingFile, relative to the project's log folder
+#ifndef UNLOG_RING_FILE_NAME
+#define UNLOG_RING_FILE_NAME TEXT("Unlog.ring")
+#endif
+
+// Bytes reserved for records, must be a power of two that fits the longest record. Oldest records are overwritten once full
+#ifndef UNLOG_RING_FILE_CAPACITY
+#define UNLOG_RING_FILE_CAPACITY (16 * 1024 * 1024)
+#endif
+
+// Categories whose names are kept in the file, records of categories past this are still written
+#ifndef UNLOG_RING_FILE_MAX_CATEGORIES
+#define UNLOG_RING_FILE_MAX_CATEGORIES 1024
+#endif
+
+// ------------------------------------------------------------------------------------
+// Binary ring file
+//
+// Always-on logging into a memory-mapped file of fixed size. Writers reserve space with
+// a single atomic add and copy their record straight into the mapping, no locks nor
+// system calls involved. Since the file is mapped, whatever was written before a crash
+// is already in the OS page cache and ends up on disk.
+//
+// File layout: FUnlogRingFileHeader followed by UNLOG_RING_FILE_CAPACITY bytes of records.
+// Each record is an FUnlogRingFileRecord followed by its message in TCHARs (not null
+// terminated) and padded to 8 bytes. Records wrap around the end of the ring.
+//
+// Use FUnlogRingFileReader to read the records back.
+// ------------------------------------------------------------------------------------
+
+struct FUnlogRingFileCategory
+{
+    static constexpr int32 MaxNameLength = 60;
+
+    // Name length in ANSI characters, 0 while the slot is unused
+    uint32 NameLength;
+    ANSICHAR Name[MaxNameLength];
+};
+
+struct FUnlogRingFileHeader
+{
+    static constexpr uint64 ExpectedMagic = 0x31474E49524C4E55ull; // "UNLRING1"
+    static constexpr uint32 ExpectedVersion = 1;
+
+    uint64 Magic;
+    uint32 Version;
+    uint32 CharSize;
+    uint64 Capacity;
+
+    // Used to convert record timestamps (in cycles) to wall clock time
+    uint64 StartCycles;
+    double SecondsPerCycle;
+    int64 StartUtcTicks;
+
+    // Monotonic offset of the next record, the ring position is WriteOffset & ( Capacity - 1 )
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> WriteOffset;
+
+    // Indexed by category id
+    alignas(PLATFORM_CACHE_LINE_SIZE) FUnlogRingFileCategory Categories[UNLOG_RING_FILE_MAX_CATEGORIES];
+};
+
+struct FUnlogRingFileRecord
+{
+    // Offset the record was reserved at. Written last, a record is only complete if it matches its position in the ring
+    uint64 Position;
+    uint64 Cycles;
+    // Total bytes including this header, the message and the padding
+    uint32 Size;
+    uint32 CategoryId;
+    uint32 ThreadId;
+    uint16 MessageLength;
+    uint8 Verbosity;
+    uint8 Reserved;
+};
+
+static_assert(sizeof(FUnlogRingFileRecord) == 32, "Ring file records are expected to be packed into 32 bytes");
+static_assert((UNLOG_RING_FILE_CAPACITY & (UNLOG_RING_FILE_CAPACITY - 1)) == 0, "UNLOG_RING_FILE_CAPACITY must be a power of two");
+static_assert(UNLOG_RING_FILE_CAPACITY >= sizeof(FUnlogRingFileRecord) + MAX_uint16 * sizeof(TCHAR), "UNLOG_RING_FILE_CAPACITY must fit a record holding the longest message kept (MAX_uint16 characters)");
+
+// Owns the mapping, shared by every logger using Target::BinaryRingFile
+class FUnlogRingFile
+{
+public:
+    static FUnlogRingFile& Get()
+    {
+        static FUnlogRingFile RingFile(FPaths::Combine(FPaths::ProjectLogDir(), UNLOG_RING_FILE_NAME));
+        return RingFile;
+    }
+
+    bool IsMapped() const
+    {
+        return Header != nullptr;
+    }
+
+    const FString& GetPath() const
+    {
+        return Path;
+    }
+
+    void Write(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+    {
+        if (!IsMapped())
+        {
+            return;
+        }
+
+        const uint32 CategoryId = Category.GetId();
+        if (CategoryId < UNLOG_RING_FILE_MAX_CATEGORIES && !KnownCategories[CategoryId].load(std::memory_order_relaxed))
+        {
+            WriteCategoryName(Category);
+        }
+
+        const int32 MessageLength = FMath::Min<int32>(Message.Len(), MAX_uint16);
+        const uint32 MessageBytes = MessageLength * sizeof(TCHAR);
+        const uint32 Size = Align<uint32>(sizeof(FUnlogRingFileRecord) + MessageBytes, 8);
+
+        FUnlogRingFileRecord Record;
+        Record.Position = Header->WriteOffset.fetch_add(Size, std::memory_order_relaxed);
+        Record.Cycles = FPlatformTime::Cycles64();
+        Record.Size = Size;
+        Record.CategoryId = CategoryId;
+        Record.ThreadId = FPlatformTLS::GetCurrentThreadId();
+        Record.MessageLength = (uint16)MessageLength;
+        Record.Verbosity = (uint8)Verbosity;
+        Record.Reserved = 0;
+
+        // Everything but the position first, so a record torn by a crash never looks complete
+        const uint64 Position = Record.Position;
+        WriteWrapped(Position + sizeof(uint64), reinterpret_cast<const uint8*>(&Record) + sizeof(uint64), sizeof(FUnlogRingFileRecord) - sizeof(uint64));
+        WriteWrapped(Position + sizeof(FUnlogRingFileRecord), reinterpret_cast<const uint8*>(Message.GetData()), MessageBytes);
+
+        std::atomic_thread_fence(std::memory_order_release);
+        // Positions are 8 bytes aligned and so is the capacity, the position never wraps
+        FMemory::Memcpy(Records + (Position & (UNLOG_RING_FILE_CAPACITY - 1)), &Position, sizeof(uint64));
+    }
+
+private:
+    explicit FUnlogRingFile(const FString& InPath)
+        : Path(InPath)
+        , Header(nullptr)
+        , Records(nullptr)
+        , MappingSize(sizeof(FUnlogRingFileHeader) + UNLOG_RING_FILE_CAPACITY)
+    {
+        for (std::atomic<bool>& Known : KnownCategories)
+        {
+            Known.store(false, std::memory_order_relaxed);
+        }
+
+        // Keep the previous run's file around, it's the interesting one after a crash
+        IFileManager& FileManager = IFileManager::Get();
+        FileManager.MakeDirectory(*FPaths::ProjectLogDir(), true);
+        if (FileManager.FileExists(*Path))
+        {
+            FileManager.Move(*(Path + TEXT(".prev")), *Path, true);
+        }
+
+        uint8* Mapping = Map();
+        if (!Mapping)
+        {
+            return;
+        }
+
+        Header = new (Mapping) FUnlogRingFileHeader();
+        Header->Magic = FUnlogRingFileHeader::ExpectedMagic;
+        Header->Version = FUnlogRingFileHeader::ExpectedVersion;
+        Header->CharSize = sizeof(TCHAR);
+        Header->Capacity = UNLOG_RING_FILE_CAPACITY;
+        Header->StartCycles = FPlatformTime::Cycles64();
+        Header->SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+        Header->StartUtcTicks = FDateTime::UtcNow().GetTicks();
+        Header->WriteOffset.store(0, std::memory_order_relaxed);
+        FMemory::Memzero(Header->Categories, sizeof(Header->Categories));
+
+        Records = Mapping + sizeof(FUnlogRingFileHeader);
+    }
+
+    ~FUnlogRingFile()
+    {
+        Unmap();
+    }
+
+    template< typename T >
+    static constexpr T Align(T Value, T Alignment)
+    {
+        return (Value + Alignment - 1) & ~(Alignment - 1);
+    }
+
+    void WriteWrapped(uint64 Position, const uint8* Data, uint32 Size)
+    {
+        const uint32 Start = (uint32)(Position & (UNLOG_RING_FILE_CAPACITY - 1));
+        const uint32 FirstPart = FMath::Min<uint32>(Size, UNLOG_RING_FILE_CAPACITY - Start);
+
+        FMemory::Memcpy(Records + Start, Data, FirstPart);
+        if (FirstPart < Size)
+        {
+            FMemory::Memcpy(Records, Data + FirstPart, Size - FirstPart);
+        }
+    }
+
+    void WriteCategoryName(const UnlogCategoryBase& Category)
+    {
+        // Only the first thread to see the category writes its name
+        if (KnownCategories[Category.GetId()].exchange(true))
+        {
+            return;
+        }
+
+        const FString Name = Category.GetName().ToString();
+        FUnlogRingFileCategory& Entry = Header->Categories[Category.GetId()];
+
+        const int32 NameLength = FMath::Min<int32>(Name.Len(), FUnlogRingFileCategory::MaxNameLength);
+        for (int32 Index = 0; Index < NameLength; ++Index)
+        {
+            // Category names are identifiers so ANSI is enough
+            Entry.Name[Index] = (ANSICHAR)(*Name)[Index];
+        }
+
+        std::atomic_thread_fence(std::memory_order_release);
+        Entry.NameLength = NameLength;
+    }
+
+#if PLATFORM_WINDOWS
+    uint8* Map()
+    {
+        FileHandle = CreateFileW(*Path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (FileHandle == INVALID_HANDLE_VALUE)
+        {
+            return nullptr;
+        }
+
+        MappingHandle = CreateFileMappingW(FileHandle, nullptr, PAGE_READWRITE, (DWORD)((uint64)MappingSize >> 32), (DWORD)MappingSize, nullptr);
+        if (!MappingHandle)
+        {
+            CloseHandle(FileHandle);
+            return nullptr;
+        }
+
+        void* View = MapViewOfFile(MappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, MappingSize);
+        if (!View)
+        {
+            CloseHandle(MappingHandle);
+            CloseHandle(FileHandle);
+            return nullptr;
+        }
+        return static_cast<uint8*>(View);
+    }
+
+    void Unmap()
+    {
+        if (Header)
+        {
+            UnmapViewOfFile(Header);
+            CloseHandle(MappingHandle);
+            CloseHandle(FileHandle);
+            Header = nullptr;
+        }
+    }
+
+    HANDLE FileHandle;
+    HANDLE MappingHandle;
+#elif PLATFORM_UNIX || PLATFORM_MAC
+    uint8* Map()
+    {
+        FileDescriptor = open(TCHAR_TO_UTF8(*Path), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (FileDescriptor < 0)
+        {
+            return nullptr;
+        }
+
+        if (ftruncate(FileDescriptor, MappingSize) != 0)
+        {
+            close(FileDescriptor);
+            return nullptr;
+        }
+
+        void* View = mmap(nullptr, MappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, FileDescriptor, 0);
+        if (View == MAP_FAILED)
+        {
+            close(FileDescriptor);
+            return nullptr;
+        }
+        return static_cast<uint8*>(View);
+    }
+
+    void Unmap()
+    {
+        if (Header)
+        {
+            munmap(Header, MappingSize);
+            close(FileDescriptor);
+            Header = nullptr;
+        }
+    }
+
+    int FileDescriptor;
+#else
+    // No memory mapping support, the target won't write anything
+    uint8* Map()
+    {
+        return nullptr;
+    }
+
+    void Unmap()
+    {}
+#endif
+
+    FString Path;
+    FUnlogRingFileHeader* Header;
+    uint8* Records;
+    SIZE_T MappingSize;
+    std::atomic<bool> KnownCategories[UNLOG_RING_FILE_MAX_CATEGORIES];
+};
+
+/**
+* Reads the records back from a ring file loaded in memory, oldest first.
+* e.g: FFileHelper::LoadFileToArray( Data, TEXT("Unlog.ring") ) then FUnlogRingFileReader( Data.GetData(), Data.Num() )
+*/
+class FUnlogRingFileReader
+{
+public:
+    struct FEntry
+    {
+        double SecondsSinceStart;
+        const ANSICHAR* CategoryName;
+        int32 CategoryNameLength;
+        uint32 CategoryId;
+        uint32 ThreadId;
+        ELogVerbosity::Type Verbosity;
+        FStringView Message;
+    };
+
+    FUnlogRingFileReader(const uint8* InData, int64 InSize)
+        : Header(nullptr)
+        , Records(nullptr)
+    {
+        const FUnlogRingFileHeader* Candidate = reinterpret_cast<const FUnlogRingFileHeader*>(InData);
+        if (InSize >= (int64)sizeof(FUnlogRingFileHeader)
+            && Candidate->Magic == FUnlogRingFileHeader::ExpectedMagic
+            && Candidate->Version == FUnlogRingFileHeader::ExpectedVersion
+            && Candidate->CharSize == sizeof(TCHAR)
+            && InSize >= (int64)(sizeof(FUnlogRingFileHeader) + Candidate->Capacity))
+        {
+            Header = Candidate;
+            Records = InData + sizeof(FUnlogRingFileHeader);
+        }
+    }
+
+    bool IsValid() const
+    {
+        return Header != nullptr;
+    }
+
+    // Complete records still in the ring, in the order they were reserved
+    void ForEachRecord(TFunctionRef<void(const FEntry&)> Visitor) const
+    {
+        if (!IsValid())
+        {
+            return;
+        }
+
+        const uint64 Capacity = Header->Capacity;
+        const uint64 End = Header->WriteOffset.load(std::memory_order_acquire);
+        uint64 Position = End > Capacity ? End - Capacity : 0;
+
+        TArray<uint8> Scratch;
+        while (Position + sizeof(FUnlogRingFileRecord) <= End)
+        {
+            FUnlogRingFileRecord Record;
+            Read(Position, reinterpret_cast<uint8*>(&Record), sizeof(Record));
+
+            // The oldest records were partially overwritten, look for the next one that's intact
+            const bool bIsComplete = Record.Position == Position && Record.Size >= sizeof(FUnlogRingFileRecord) && Position + Record.Size <= End;
+            if (!bIsComplete)
+            {
+                Position += 8;
+                continue;
+            }
+
+            const uint32 MessageBytes = Record.MessageLength * sizeof(TCHAR);
+            Scratch.SetNum(MessageBytes + sizeof(TCHAR));
+            Read(Position + sizeof(FUnlogRingFileRecord), Scratch.GetData(), MessageBytes);
+            FMemory::Memzero(Scratch.GetData() + MessageBytes, sizeof(TCHAR));
+
+            const FUnlogRingFileCategory* Category = Record.CategoryId < UNLOG_RING_FILE_MAX_CATEGORIES ? &Header->Categories[Record.CategoryId] : nullptr;
+
+            FEntry Entry;
+            Entry.SecondsSinceStart = (double)(Record.Cycles - Header->StartCycles) * Header->SecondsPerCycle;
+            Entry.CategoryName = Category ? Category->Name : "";
+            Entry.CategoryNameLength = Category ? (int32)Category->NameLength : 0;
+            Entry.CategoryId = Record.CategoryId;
+            Entry.ThreadId = Record.ThreadId;
+            Entry.Verbosity = (ELogVerbosity::Type)Record.Verbosity;
+            Entry.Message = FStringView(reinterpret_cast<const TCHAR*>(Scratch.GetData()), Record.MessageLength);
+            Visitor(Entry);
+
+            Position += Record.Size;
+        }
+    }
+
+private:
+    void Read(uint64 Position, uint8* Out, uint32 Size) const
+    {
+        const uint64 Capacity = Header->Capacity;
+        const uint32 Start = (uint32)(Position & (Capacity - 1));
+        const uint32 FirstPart = (uint32)FMath::Min<uint64>(Size, Capacity - Start);
+
+        FMemory::Memcpy(Out, Records + Start, FirstPart);
+        if (FirstPart < Size)
+        {
+            FMemory::Memcpy(Out + FirstPart, Records, Size - FirstPart);
+        }
+    }
+
+    const FUnlogRingFileHeader* Header;
+    const uint8* Records;
+};
+
+namespace Target
+{
+    /**
+    * Writes compact binary records into a memory-mapped ring file in the project's log folder,
+    * keeping the last UNLOG_RING_FILE_CAPACITY bytes worth of messages. Cheap enough to be always on.
+    * The previous run's file is kept with a .prev extension.
+    */
+    struct BinaryRingFile
+    {
+        static void Call(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            FUnlogRingFile::Get().Write(Category, Verbosity, Message);
+        }
+    };
+}
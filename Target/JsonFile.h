@@ -0,0 +1,402 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <HAL/FileManager.h>
+#include <Misc/Paths.h>
+#include <Misc/DateTime.h>
+
+// File written by Target::JsonFile, relative to the project's log folder
+#ifndef UNLOG_JSON_FILE_NAME
+#define UNLOG_JSON_FILE_NAME TEXT("Unlog.jsonl")
+#endif
+
+// ------------------------------------------------------------------------------------
+// JSON file
+//
+// Writes one JSON object per message (JSON Lines) for log processors to ingest without
+// parsing the text. Fields passed with UNLOG_FIELD keep their type, numbers are written
+// as JSON numbers and everything else as strings:
+//
+// {"time":1700000000.123456,"category":"LogGeneral","verbosity":"Log",
+//  "message":"Spawned","fields":{"ActorName":"Bob","Health":100}}
+//
+// The message is rendered without the fields appended to it, "fields" is left out for
+// messages without any. Time is in seconds since the Unix epoch, UTC.
+//
+// Lines are built in an inline buffer straight from the logging call's arguments and
+// converted to UTF-8 in chunks, so most messages are written without touching the heap.
+// Writes are buffered, the file is flushed on errors, on exit and when calling Unlog::Flush.
+// ------------------------------------------------------------------------------------
+
+// Builds the lines written by Target::JsonFile, usable on its own to convert messages read back from other targets
+struct FUnlogJsonLine
+{
+    static void Build(FStringBuilderBase& Out, double UnixTime, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message, const FUnlogFormatArg* Args, int32 NumArgs)
+    {
+        AppendMessage(Out, UnixTime, Category, Verbosity, Message);
+
+        bool bHasFields = false;
+        for (int32 Index = 0; Index < NumArgs; ++Index)
+        {
+            // Arguments that aren't fields are already part of the message
+            if (Args[Index].FieldName)
+            {
+                AppendFieldName(Out, bHasFields, Args[Index].FieldName, FCString::Strlen(Args[Index].FieldName));
+                AppendValue(Out, Args[Index]);
+            }
+        }
+
+        Out.Append(bHasFields ? TEXT("}}") : TEXT("}"));
+    }
+
+    // Same as above for arguments read back with FUnlogArgReader::Decode
+    static void Build(FStringBuilderBase& Out, double UnixTime, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message, const FUnlogDecodedArg* Args, int32 NumArgs)
+    {
+        AppendMessage(Out, UnixTime, Category, Verbosity, Message);
+
+        bool bHasFields = false;
+        for (int32 Index = 0; Index < NumArgs; ++Index)
+        {
+            if (!Args[Index].Name.IsEmpty())
+            {
+                AppendFieldName(Out, bHasFields, *Args[Index].Name, Args[Index].Name.Len());
+                AppendValue(Out, Args[Index]);
+            }
+        }
+
+        Out.Append(bHasFields ? TEXT("}}") : TEXT("}"));
+    }
+
+    static void AppendValue(FStringBuilderBase& Out, const FUnlogFormatArg& Arg)
+    {
+        // Encoding gives the argument a plain type JSON can represent. Numbers and booleans fit in the buffer,
+        // strings don't and get their text escaped instead of being cut short
+        uint8 Encoded[1 + sizeof(uint64)];
+        FUnlogArgWriter Writer(Encoded, sizeof(Encoded));
+        Arg.EncodeTo(Writer, Arg.Value);
+
+        const EUnlogArgType Type = Writer.Num() > 0 ? (EUnlogArgType)Encoded[0] : EUnlogArgType::String;
+        switch (Type)
+        {
+        case EUnlogArgType::Signed:
+            AppendSigned(Out, ReadEncoded<int64>(Encoded));
+            break;
+        case EUnlogArgType::Unsigned:
+            AppendUnsigned(Out, ReadEncoded<uint64>(Encoded));
+            break;
+        case EUnlogArgType::Double:
+            AppendDouble(Out, ReadEncoded<double>(Encoded));
+            break;
+        case EUnlogArgType::Bool:
+            AppendBool(Out, Encoded[1] != 0);
+            break;
+        default:
+        {
+            TStringBuilder<UNLOG_INLINE_BUFFER_SIZE> Text;
+            Arg.AppendTo(Text, Arg.Value);
+            AppendString(Out, Text.ToString(), Text.Len());
+            break;
+        }
+        }
+    }
+
+    static void AppendValue(FStringBuilderBase& Out, const FUnlogDecodedArg& Arg)
+    {
+        switch (Arg.Type)
+        {
+        case EUnlogArgType::Signed:
+            AppendSigned(Out, Arg.Signed);
+            break;
+        case EUnlogArgType::Unsigned:
+            AppendUnsigned(Out, Arg.Unsigned);
+            break;
+        case EUnlogArgType::Double:
+            AppendDouble(Out, Arg.Double);
+            break;
+        case EUnlogArgType::Bool:
+            AppendBool(Out, Arg.Bool);
+            break;
+        default:
+            AppendString(Out, *Arg.String, Arg.String.Len());
+            break;
+        }
+    }
+
+    // Outputs Chars as a quoted JSON string
+    static void AppendString(FStringBuilderBase& Out, const TCHAR* Chars, int32 Length)
+    {
+        Out.AppendChar(TEXT('"'));
+        for (int32 Index = 0; Index < Length; ++Index)
+        {
+            const TCHAR Char = Chars[Index];
+            switch (Char)
+            {
+            case TEXT('"'):  Out.Append(TEXT("\\\"")); break;
+            case TEXT('\\'): Out.Append(TEXT("\\\\")); break;
+            case TEXT('\n'): Out.Append(TEXT("\\n")); break;
+            case TEXT('\r'): Out.Append(TEXT("\\r")); break;
+            case TEXT('\t'): Out.Append(TEXT("\\t")); break;
+            default:
+                if (Char < 0x20)
+                {
+                    Out.Appendf(TEXT("\\u%04x"), (uint32)Char);
+                }
+                else
+                {
+                    Out.AppendChar(Char);
+                }
+                break;
+            }
+        }
+        Out.AppendChar(TEXT('"'));
+    }
+
+    static void AppendSigned(FStringBuilderBase& Out, int64 Value)
+    {
+        Out.Appendf(TEXT("%lld"), (long long)Value);
+    }
+
+    static void AppendUnsigned(FStringBuilderBase& Out, uint64 Value)
+    {
+        Out.Appendf(TEXT("%llu"), (unsigned long long)Value);
+    }
+
+    static void AppendDouble(FStringBuilderBase& Out, double Value)
+    {
+        // JSON has no representation for them
+        if (FMath::IsFinite(Value))
+        {
+            Out.Appendf(TEXT("%.17g"), Value);
+        }
+        else
+        {
+            Out.Append(TEXT("null"));
+        }
+    }
+
+    static void AppendBool(FStringBuilderBase& Out, bool Value)
+    {
+        Out.Append(Value ? TEXT("true") : TEXT("false"));
+    }
+
+    static double GetUnixTime()
+    {
+        constexpr int64 UnixEpochTicks = 621355968000000000ll;
+        constexpr double TicksPerSecond = 10000000.0;
+        return (FDateTime::UtcNow().GetTicks() - UnixEpochTicks) / TicksPerSecond;
+    }
+
+private:
+    static void AppendMessage(FStringBuilderBase& Out, double UnixTime, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+    {
+        Out.Appendf(TEXT("{\"time\":%.6f,\"category\":"), UnixTime);
+        TStringBuilder<128> CategoryName;
+        Category.GetName().AppendString(CategoryName);
+        AppendString(Out, CategoryName.ToString(), CategoryName.Len());
+
+        Out.Append(TEXT(",\"verbosity\":"));
+        const TCHAR* VerbosityName = ToString(Verbosity);
+        AppendString(Out, VerbosityName, FCString::Strlen(VerbosityName));
+
+        Out.Append(TEXT(",\"message\":"));
+        AppendString(Out, Message.GetData(), Message.Len());
+    }
+
+    static void AppendFieldName(FStringBuilderBase& Out, bool& bHasFields, const TCHAR* Name, int32 Length)
+    {
+        Out.Append(bHasFields ? TEXT(",") : TEXT(",\"fields\":{"));
+        AppendString(Out, Name, Length);
+        Out.AppendChar(TEXT(':'));
+        bHasFields = true;
+    }
+
+    // The value following the type byte, copied out since it isn't aligned
+    template< typename T >
+    static T ReadEncoded(const uint8* Encoded)
+    {
+        T Value;
+        FMemory::Memcpy(&Value, Encoded + 1, sizeof(T));
+        return Value;
+    }
+};
+
+// Owns the file, shared by every logger using Target::JsonFile
+class FUnlogJsonFile : public FUnlogFlushable
+{
+public:
+    // Never destroyed, other threads may still be logging while statics are torn down on exit
+    static FUnlogJsonFile& Get()
+    {
+        static FUnlogJsonFile* JsonFile = new FUnlogJsonFile(FPaths::Combine(FPaths::ProjectLogDir(), UNLOG_JSON_FILE_NAME));
+        return *JsonFile;
+    }
+
+    bool IsOpen() const
+    {
+        return Writer != nullptr;
+    }
+
+    const FString& GetPath() const
+    {
+        return Path;
+    }
+
+    void Write(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FUnlogMessageArgs& Args)
+    {
+        if (!IsOpen())
+        {
+            return;
+        }
+
+        // Reuses the text when another target already needed it
+        if (Args.IsFormatted())
+        {
+            WriteLine(Category, Verbosity, Args.GetMessageWithoutFields(), Args.Args, Args.NumArgs);
+            return;
+        }
+
+        TStringBuilder<UNLOG_INLINE_BUFFER_SIZE> Message;
+        Args.RenderWithoutFields(Message);
+        WriteLine(Category, Verbosity, FStringView(Message.ToString(), Message.Len()), Args.Args, Args.NumArgs);
+    }
+
+    void Write(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+    {
+        if (IsOpen())
+        {
+            WriteLine(Category, Verbosity, Message, nullptr, 0);
+        }
+    }
+
+    // Writes to disk, never hands messages to anything else
+    virtual bool Flush() override
+    {
+        FScopeLock Lock(&WriterLock);
+        if (Writer)
+        {
+            Writer->Flush();
+        }
+        return false;
+    }
+
+private:
+    explicit FUnlogJsonFile(const FString& InPath)
+        : Path(InPath)
+        , Writer(nullptr)
+    {
+        // Keep the previous run's file around, same as the engine's log
+        IFileManager& FileManager = IFileManager::Get();
+        FileManager.MakeDirectory(*FPaths::ProjectLogDir(), true);
+        if (FileManager.FileExists(*Path))
+        {
+            FileManager.Move(*(Path + TEXT(".prev")), *Path, true);
+        }
+
+        Writer = FileManager.CreateFileWriter(*Path, FILEWRITE_AllowRead);
+        Register(this);
+
+        // Never destroyed, so whatever is still buffered has to be written out before the app goes away
+        FUnlogGameThread::Run([this]
+        {
+            FCoreDelegates::OnExit.AddRaw(this, &FUnlogJsonFile::FlushOnExit);
+        });
+    }
+
+    void FlushOnExit()
+    {
+        Flush();
+    }
+
+    void WriteLine(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message, const FUnlogFormatArg* Args, int32 NumArgs)
+    {
+        TStringBuilder<UNLOG_INLINE_BUFFER_SIZE> Line;
+        FUnlogJsonLine::Build(Line, FUnlogJsonLine::GetUnixTime(), Category, Verbosity, Message, Args, NumArgs);
+        Line.AppendChar(TEXT('\n'));
+
+        FScopeLock Lock(&WriterLock);
+        SerializeUtf8(Line.ToString(), Line.Len());
+
+        // Errors are likely followed by a crash, make sure they make it to disk
+        if (Verbosity <= ELogVerbosity::Error)
+        {
+            Writer->Flush();
+        }
+    }
+
+    // Converts into a stack buffer written out whenever it fills up, lines of any length never allocate
+    void SerializeUtf8(const TCHAR* Chars, int32 Length)
+    {
+        uint8 Buffer[512];
+        int32 Size = 0;
+        for (int32 Index = 0; Index < Length; ++Index)
+        {
+            uint32 Code = (uint32)Chars[Index];
+
+            // Characters outside the BMP are surrogate pairs where TCHAR is 16 bits
+            if (Code >= 0xD800 && Code <= 0xDBFF && Index + 1 < Length && (uint32)Chars[Index + 1] >= 0xDC00 && (uint32)Chars[Index + 1] <= 0xDFFF)
+            {
+                Code = 0x10000 + ((Code - 0xD800) << 10) + ((uint32)Chars[++Index] - 0xDC00);
+            }
+            else if ((Code >= 0xD800 && Code <= 0xDFFF) || Code > 0x10FFFF)
+            {
+                Code = 0xFFFD;
+            }
+
+            if (Size + 4 > (int32)sizeof(Buffer))
+            {
+                Writer->Serialize(Buffer, Size);
+                Size = 0;
+            }
+
+            if (Code < 0x80)
+            {
+                Buffer[Size++] = (uint8)Code;
+            }
+            else if (Code < 0x800)
+            {
+                Buffer[Size++] = (uint8)(0xC0 | (Code >> 6));
+                Buffer[Size++] = (uint8)(0x80 | (Code & 0x3F));
+            }
+            else if (Code < 0x10000)
+            {
+                Buffer[Size++] = (uint8)(0xE0 | (Code >> 12));
+                Buffer[Size++] = (uint8)(0x80 | ((Code >> 6) & 0x3F));
+                Buffer[Size++] = (uint8)(0x80 | (Code & 0x3F));
+            }
+            else
+            {
+                Buffer[Size++] = (uint8)(0xF0 | (Code >> 18));
+                Buffer[Size++] = (uint8)(0x80 | ((Code >> 12) & 0x3F));
+                Buffer[Size++] = (uint8)(0x80 | ((Code >> 6) & 0x3F));
+                Buffer[Size++] = (uint8)(0x80 | (Code & 0x3F));
+            }
+        }
+
+        Writer->Serialize(Buffer, Size);
+    }
+
+    FString Path;
+    FArchive* Writer;
+    FCriticalSection WriterLock;
+};
+
+namespace Target
+{
+    /**
+    * Writes messages as JSON Lines into the project's log folder, see FUnlogJsonFile.
+    * Fields keep their names and types instead of being flattened into the text.
+    * e.g: TUnlog<>::WithTargets< Target::UELog, Target::JsonFile >
+    */
+    struct JsonFile
+    {
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FUnlogMessageArgs& Args)
+        {
+            FUnlogJsonFile::Get().Write(Category, Verbosity, Args);
+        }
+
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            FUnlogJsonFile::Get().Write(Category, Verbosity, Message);
+        }
+    };
+}
@@ -4,11 +4,25 @@
 #include <Developer/MessageLog/Public/MessageLogModule.h>
 #include <Developer/MessageLog/Public/IMessageLogListing.h>
 #include <Modules/ModuleManager.h>
+#include <Misc/ScopeLock.h>
+#include <Misc/CoreDelegates.h>
+
+// Pending messages that force a batched Message Log submission before the end of the frame
+#ifndef UNLOG_MESSAGE_LOG_BATCH_SIZE
+#define UNLOG_MESSAGE_LOG_BATCH_SIZE 1024
+#endif
 
 namespace Target
 {
     struct MessageLog
     {
+        // Loaded on first use, the module outlives anything that could still be logging
+        static FMessageLogModule& GetModule()
+        {
+            static FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
+            return MessageLogModule;
+        }
+
         static TSharedRef<IMessageLogListing> GetLogListing(FMessageLogModule& MessageLogModule, const FName& CategoryName)
         {
             auto Listing = MessageLogModule.GetLogListing(CategoryName);
@@ -16,6 +30,23 @@ namespace Target
             return Listing;
         }
 
+        // Same as above but cached per category, so the listing lookup and its label only happen once
+        static IMessageLogListing& GetLogListing(const UnlogCategoryBase& Category)
+        {
+            static FCriticalSection ListingsLock;
+            static TMap< const UnlogCategoryBase*, TSharedRef<IMessageLogListing> > Listings;
+
+            FScopeLock Lock(&ListingsLock);
+
+            if (const TSharedRef<IMessageLogListing>* Listing = Listings.Find(&Category))
+            {
+                return Listing->Get();
+            }
+
+            // Categories live for the rest of the app's execution so their address is a stable key
+            return Listings.Add(&Category, GetLogListing(GetModule(), Category.GetName())).Get();
+        }
+
         static EMessageSeverity::Type VerbosityToSeverity(ELogVerbosity::Type Verbosity)
         {
             switch (Verbosity)
@@ -24,26 +55,151 @@ namespace Target
                 return EMessageSeverity::Error;
             case ELogVerbosity::Warning:
                 return EMessageSeverity::Warning;
+            default:
+                return EMessageSeverity::Info;
             }
-            return EMessageSeverity::Info;
         }
 
-        static void Call(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FString& Message)
+        static void Call(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
         {
-            FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
-
-            auto LogListing = GetLogListing(MessageLogModule, Category.GetName());
-            LogListing->AddMessage(
+            GetLogListing(Category).AddMessage(
                 FTokenizedMessage::Create(
                     VerbosityToSeverity(Verbosity),
-                    FText::FromString(Message)
+                    FText::FromString(FString(Message.Len(), Message.GetData()))
                 )
             );
 
             if (Verbosity == ELogVerbosity::Error)
             {
-                MessageLogModule.OpenMessageLog(Category.GetName());
+                GetModule().OpenMessageLog(Category.GetName());
             }
         }
     };
-}
\ No newline at end of file
+
+    /**
+    * Same as MessageLog but messages are buffered per category and submitted together at the end of
+    * the frame, opening the log at most once. Recommended when lots of messages can be raised in a
+    * short period of time (e.g validation commandlets).
+    * 
+    * Submitted earlier when UNLOG_MESSAGE_LOG_BATCH_SIZE messages are pending, since commandlets
+    * don't tick frames, when calling Unlog::Flush and on exit. Full batches are always submitted
+    * from the game thread, messages keep piling up meanwhile.
+    */
+    struct BatchedMessageLog
+    {
+        static void Call(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            FBatch::Get().Add(Category, Verbosity, Message);
+        }
+
+        class FBatch : public FUnlogFlushable
+        {
+        public:
+            static FBatch& Get()
+            {
+                static FBatch Batch;
+                return Batch;
+            }
+
+            void Add(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+            {
+                TSharedRef<FTokenizedMessage> TokenizedMessage = FTokenizedMessage::Create(
+                    MessageLog::VerbosityToSeverity(Verbosity),
+                    FText::FromString(FString(Message.Len(), Message.GetData()))
+                );
+
+                bool bShouldFlush = false;
+                {
+                    FScopeLock Lock(&PendingLock);
+                    Pending.FindOrAdd(&Category).Add(TokenizedMessage);
+
+                    if (Verbosity == ELogVerbosity::Error)
+                    {
+                        CategoryToOpen = &Category;
+                    }
+
+                    bShouldFlush = ++NumPending >= UNLOG_MESSAGE_LOG_BATCH_SIZE;
+                }
+
+                // Listings aren't thread safe, submissions triggered by other threads are left to the game thread
+                if (bShouldFlush && !bSubmitScheduled.exchange(true))
+                {
+                    FUnlogGameThread::Run([this]
+                    {
+                        bSubmitScheduled = false;
+                        Flush();
+                    });
+                }
+            }
+
+            virtual bool Flush() override
+            {
+                // Keeps concurrent flushes from submitting out of order
+                FScopeLock SubmitLock(&SubmittingLock);
+
+                TMap< const UnlogCategoryBase*, TArray< TSharedRef<FTokenizedMessage> > > Submitting;
+                const UnlogCategoryBase* Opening = nullptr;
+                {
+                    FScopeLock Lock(&PendingLock);
+                    Submitting = MoveTemp(Pending);
+                    Opening = CategoryToOpen;
+                    Pending.Reset();
+                    CategoryToOpen = nullptr;
+                    NumPending = 0;
+                }
+
+                for (const auto& Pair : Submitting)
+                {
+                    MessageLog::GetLogListing(*Pair.Key).AddMessages(Pair.Value);
+                }
+
+                if (Opening)
+                {
+                    MessageLog::GetModule().OpenMessageLog(Opening->GetName());
+                }
+                return Submitting.Num() > 0;
+            }
+
+        private:
+            FBatch()
+                : CategoryToOpen(nullptr)
+                , NumPending(0)
+                , bSubmitScheduled(false)
+            {
+                Register(this);
+                FUnlogGameThread::Run([this]
+                {
+                    EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FBatch::SubmitPending);
+                    ExitHandle = FCoreDelegates::OnExit.AddRaw(this, &FBatch::SubmitAll);
+                });
+            }
+
+            virtual ~FBatch()
+            {
+                FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+                FCoreDelegates::OnExit.Remove(ExitHandle);
+                Unregister(this);
+            }
+
+            void SubmitPending()
+            {
+                Flush();
+            }
+
+            // Messages still queued on their way here (e.g by async loggers) are submitted along with the batch
+            void SubmitAll()
+            {
+                FUnlogFlushable::FlushAll();
+            }
+
+            FCriticalSection SubmittingLock;
+            FCriticalSection PendingLock;
+            TMap< const UnlogCategoryBase*, TArray< TSharedRef<FTokenizedMessage> > > Pending;
+            const UnlogCategoryBase* CategoryToOpen;
+            int32 NumPending;
+            std::atomic<bool> bSubmitScheduled;
+            FDelegateHandle EndFrameHandle;
+            FDelegateHandle ExitHandle;
+        };
+    };
+}
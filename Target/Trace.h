@@ -0,0 +1,234 @@
+// Copyright 2023 Guganana. All Rights Reserved.
+#pragma once
+
+#include <Trace/Trace.h>
+
+// Bytes of encoded arguments sent with each message, see FUnlogArgWriter for what happens to the ones that don't fit
+#ifndef UNLOG_TRACE_ARGS_CAPACITY
+#define UNLOG_TRACE_ARGS_CAPACITY 1024
+#endif
+
+// Call sites described in the trace, messages of call sites past this are sent as text
+#ifndef UNLOG_TRACE_MAX_CALL_SITES
+#define UNLOG_TRACE_MAX_CALL_SITES 4096
+#endif
+
+// Categories whose names are sent, messages of categories past this are still sent
+#ifndef UNLOG_TRACE_MAX_CATEGORIES
+#define UNLOG_TRACE_MAX_CATEGORIES 1024
+#endif
+
+#if UE_TRACE_ENABLED
+
+// ------------------------------------------------------------------------------------
+// Trace
+//
+// Sends messages to Unreal Insights on UnlogChannel, next to the CPU scopes of the same
+// frame. Messages are never formatted, each Unlog.Message event only carries the call
+// site id, category, verbosity and the arguments encoded by FUnlogArgWriter. Call sites
+// and categories are described once through important events, so they're also known
+// to sessions connecting late:
+//
+// Unlog.Category   Id, Name
+// Unlog.CallSite   Id, CategoryId, Line, CharSize, File, Function, Format
+// Unlog.Message    Cycle, CallSiteId, CategoryId, Verbosity, Args, Text
+//
+// Tools reading the trace render messages with FUnlogArgReader::Render( Format, Args ).
+// Only the macros' static formats are sent that way, Text is filled for every other
+// message: calls through the logging functions (their format may be built at runtime
+// and have no call site), printf formats and the messages Unlog produces itself.
+//
+// The channel is off by default, enable it with -trace=default,Unlog or by running
+// Trace.Enable Unlog. The channel and events are shared by every translation unit,
+// expand UNLOG_TRACE_DEFINE() in exactly one .cpp of each module including this file.
+// ------------------------------------------------------------------------------------
+
+UE_TRACE_CHANNEL_EXTERN(UnlogChannel)
+
+UE_TRACE_EVENT_BEGIN_EXTERN(Unlog, Category, NoSync | Important)
+    UE_TRACE_EVENT_FIELD(uint32, Id)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Name)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN_EXTERN(Unlog, CallSite, NoSync | Important)
+    UE_TRACE_EVENT_FIELD(uint32, Id)
+    UE_TRACE_EVENT_FIELD(uint32, CategoryId)
+    UE_TRACE_EVENT_FIELD(int32, Line)
+    UE_TRACE_EVENT_FIELD(uint8, CharSize)
+    UE_TRACE_EVENT_FIELD(UE::Trace::AnsiString, File)
+    UE_TRACE_EVENT_FIELD(UE::Trace::AnsiString, Function)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Format)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN_EXTERN(Unlog, Message)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(uint32, CallSiteId)
+    UE_TRACE_EVENT_FIELD(uint32, CategoryId)
+    UE_TRACE_EVENT_FIELD(uint8, Verbosity)
+    UE_TRACE_EVENT_FIELD(uint8[], Args)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Text)
+UE_TRACE_EVENT_END()
+
+#define UNLOG_TRACE_DEFINE() \
+    UE_TRACE_CHANNEL_DEFINE(UnlogChannel) \
+    UE_TRACE_EVENT_DEFINE(Unlog, Category) \
+    UE_TRACE_EVENT_DEFINE(Unlog, CallSite) \
+    UE_TRACE_EVENT_DEFINE(Unlog, Message)
+
+// Remembers which call sites and categories were already described, shared by every logger using Target::Trace
+class FUnlogTrace
+{
+public:
+    static FUnlogTrace& Get()
+    {
+        static FUnlogTrace Trace;
+        return Trace;
+    }
+
+    static bool IsEnabled()
+    {
+        return UE_TRACE_CHANNELEXPR_IS_ENABLED(UnlogChannel);
+    }
+
+    void Write(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FUnlogMessageArgs& Args)
+    {
+        DescribeCategory(Category);
+
+        // Only messages with a described format can be rendered offline. Call sites only exist for the macros, whose
+        // formats are literals, anything else is sent as text since its format may not outlive the call
+        const FUnlogCallSite* CallSite = Source.CallSite;
+        if (Args.Args == nullptr || CallSite == nullptr || !DescribeCallSite(*CallSite))
+        {
+            TStringBuilder<UNLOG_INLINE_BUFFER_SIZE> Text;
+            Args.Render(Text);
+            WriteMessage(CallSite, Category, Verbosity, nullptr, 0, FStringView(Text.ToString(), Text.Len()));
+            return;
+        }
+
+        uint8 ArgBytes[UNLOG_TRACE_ARGS_CAPACITY];
+        const int32 NumArgBytes = Args.Encode(ArgBytes, UNLOG_TRACE_ARGS_CAPACITY);
+        WriteMessage(CallSite, Category, Verbosity, ArgBytes, NumArgBytes, FStringView());
+    }
+
+    void Write(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Text)
+    {
+        DescribeCategory(Category);
+        WriteMessage(Source.CallSite, Category, Verbosity, nullptr, 0, Text);
+    }
+
+private:
+    FUnlogTrace()
+    {
+        for (std::atomic<bool>& Known : KnownCallSites)
+        {
+            Known.store(false, std::memory_order_relaxed);
+        }
+
+        for (std::atomic<bool>& Known : KnownCategories)
+        {
+            Known.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    static void WriteMessage(const FUnlogCallSite* CallSite, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const uint8* ArgBytes, int32 NumArgBytes, FStringView Text)
+    {
+        UE_TRACE_LOG(Unlog, Message, UnlogChannel)
+            << Message.Cycle(FPlatformTime::Cycles64())
+            << Message.CallSiteId(CallSite ? CallSite->GetId() : 0)
+            << Message.CategoryId(Category.GetId())
+            << Message.Verbosity((uint8)Verbosity)
+            << Message.Args(ArgBytes, NumArgBytes)
+            << Message.Text(Text.GetData(), Text.Len());
+    }
+
+    // Event variables are named after their events, hence the In prefixes
+    void DescribeCategory(const UnlogCategoryBase& InCategory)
+    {
+        // Only the first thread to see the category describes it
+        const uint32 Id = InCategory.GetId();
+        if (Id >= UNLOG_TRACE_MAX_CATEGORIES || KnownCategories[Id].load(std::memory_order_relaxed) || KnownCategories[Id].exchange(true))
+        {
+            return;
+        }
+
+        const FString Name = InCategory.GetName().ToString();
+        UE_TRACE_LOG(Unlog, Category, UnlogChannel)
+            << Category.Id(Id)
+            << Category.Name(*Name, Name.Len());
+    }
+
+    // Returns whether the call site's format is in the trace
+    bool DescribeCallSite(const FUnlogCallSite& InCallSite)
+    {
+        const uint32 Id = InCallSite.GetId();
+        if (Id >= UNLOG_TRACE_MAX_CALL_SITES || InCallSite.Text == nullptr)
+        {
+            return false;
+        }
+
+        if (KnownCallSites[Id].load(std::memory_order_relaxed) || KnownCallSites[Id].exchange(true))
+        {
+            return true;
+        }
+
+        UE_TRACE_LOG(Unlog, CallSite, UnlogChannel)
+            << CallSite.Id(Id)
+            << CallSite.CategoryId(InCallSite.Category ? InCallSite.Category->GetId() : 0)
+            << CallSite.Line(InCallSite.Line)
+            << CallSite.CharSize((uint8)sizeof(TCHAR))
+            << CallSite.File(InCallSite.File ? InCallSite.File : "")
+            << CallSite.Function(InCallSite.Function ? InCallSite.Function : "")
+            << CallSite.Format(InCallSite.Text);
+        return true;
+    }
+
+    std::atomic<bool> KnownCallSites[UNLOG_TRACE_MAX_CALL_SITES];
+    std::atomic<bool> KnownCategories[UNLOG_TRACE_MAX_CATEGORIES];
+};
+
+namespace Target
+{
+    /**
+    * Sends messages to Unreal Insights as trace events without formatting them, see FUnlogTrace.
+    * Loggers only using targets like this one skip formatting altogether, so keep it out of TAsync
+    * and TDeduplicate, which need the text.
+    * e.g: TUnlog<>::WithTargets< Target::Trace >
+    */
+    struct Trace
+    {
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FUnlogMessageArgs& Args)
+        {
+            if (FUnlogTrace::IsEnabled())
+            {
+                FUnlogTrace::Get().Write(Source, Category, Verbosity, Args);
+            }
+        }
+
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            if (FUnlogTrace::IsEnabled())
+            {
+                FUnlogTrace::Get().Write(Source, Category, Verbosity, Message);
+            }
+        }
+    };
+}
+
+#else
+
+#define UNLOG_TRACE_DEFINE()
+
+namespace Target
+{
+    // Trace is compiled out, nothing to send messages to
+    struct Trace
+    {
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FUnlogMessageArgs& Args)
+        {}
+
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {}
+    };
+}
+
+#endif // UE_TRACE_ENABLED
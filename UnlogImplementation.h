@@ -7,22 +7,44 @@
 #include <Misc/FileHelper.h>
 #include <Templates/EnableIf.h>
 #include <Templates/IsArrayOrRefOfType.h>
+#include <Containers/StringView.h>
+#include <Misc/StringBuilder.h>
+#include <Misc/ScopeLock.h>
+#include <Misc/CoreDelegates.h>
+#include <Async/Async.h>
+#include <Misc/Crc.h>
+#include <Misc/FeedbackContext.h>
+#include <HAL/Event.h>
+#include <HAL/PlatformProcess.h>
+#include <HAL/PlatformTime.h>
+#include <HAL/PlatformTLS.h>
+#include <HAL/IConsoleManager.h>
+#include <HAL/Runnable.h>
+#include <HAL/RunnableThread.h>
+
+#include <atomic>
 
 #define UNLOG_VERSION TEXT("0.1")
 #define UNLOG_ENABLED (!UE_BUILD_SHIPPING)
 #define UNLOG_COMPILED_OUT  
 
+// Messages are formatted into an inline buffer of this many characters, only longer messages allocate
+#ifndef UNLOG_INLINE_BUFFER_SIZE
+#define UNLOG_INLINE_BUFFER_SIZE 512
+#endif
+
 // ------------------------------------------------------------------------------------
 // Static Generation Helpers
 // Templated structs used to select the appropriate template variations when 
 // ------------------------------------------------------------------------------------
 
-template< typename InFormatOptions, typename InCategoryPicker, typename InTargetOptions >
+template< typename InFormatOptions, typename InCategoryPicker, typename InTargetOptions, typename InFilterOptions >
 struct TStaticConfiguration
 {
     using FormatOptions = InFormatOptions;
     using CategoryPicker = InCategoryPicker;
     using TargetOptions = InTargetOptions;
+    using FilterOptions = InFilterOptions;
 };
 
 template<bool InIsPrintfFormat>
@@ -38,36 +60,39 @@ struct TFormatOptions
 // ------------------------------------------------------------------------------------
 
 #if UNLOG_ENABLED
-#define UNLOG_DECLARE_CATEGORY_LOG_FUNCTION_CONDITIONALS( CategoryPicker, TargetOptions, FunctionName, VerbosityName, IsPrintf ) \
+#define UNLOG_DECLARE_CATEGORY_LOG_FUNCTION_CONDITIONALS( CategoryPicker, TargetOptions, FilterOptions, CompileTimeVerbosity, FunctionName, VerbosityName, IsPrintf ) \
     template<typename TCategory = CategoryPicker, typename FMT, typename... ArgTypes> \
-    FORCEINLINE static void FunctionName(const FMT& Format, ArgTypes... Args)\
+    FORCEINLINE static void FunctionName(const FMT& Format, ArgTypes&&... Args)\
     {\
-        using Configuration = TStaticConfiguration< TFormatOptions<IsPrintf>, CategoryPicker, TargetOptions >;\
-        Unlogger::Get().UnlogPrivateImpl< Configuration >(Format, ELogVerbosity::VerbosityName, Args...);\
+        using Configuration = TStaticConfiguration< TFormatOptions<IsPrintf>, TCategory, TargetOptions, FilterOptions >;\
+        TUnlogDispatch< (ELogVerbosity::VerbosityName <= CompileTimeVerbosity) >::template Run< Configuration >(Format, ELogVerbosity::VerbosityName, Forward<ArgTypes>(Args)...);\
     }\
     template<typename TCategory = CategoryPicker, typename FMT, typename... ArgTypes>\
-    FORCEINLINE static void FunctionName(const bool Condition, const FMT& Format, ArgTypes... Args)\
+    FORCEINLINE static void FunctionName(const bool Condition, const FMT& Format, ArgTypes&&... Args)\
     {\
         if(Condition)\
         {\
-            using Configuration = TStaticConfiguration< TFormatOptions<IsPrintf>, CategoryPicker, TargetOptions >;\
-            Unlogger::Get().UnlogPrivateImpl< Configuration >(Format, ELogVerbosity::VerbosityName, Args...);\
+            using Configuration = TStaticConfiguration< TFormatOptions<IsPrintf>, TCategory, TargetOptions, FilterOptions >;\
+            TUnlogDispatch< (ELogVerbosity::VerbosityName <= CompileTimeVerbosity) >::template Run< Configuration >(Format, ELogVerbosity::VerbosityName, Forward<ArgTypes>(Args)...);\
         }\
     }\
     template<typename TCategory = CategoryPicker, typename FMT, typename... ArgTypes>\
-    FORCEINLINE static void FunctionName(const TFunction<bool()>& LambdaCondition, const FMT& Format, ArgTypes... Args)\
+    FORCEINLINE static void FunctionName(const TFunction<bool()>& LambdaCondition, const FMT& Format, ArgTypes&&... Args)\
     {\
-        FunctionName( LambdaCondition(), Format, Args... );\
+        if(ELogVerbosity::VerbosityName <= CompileTimeVerbosity)\
+        {\
+            FunctionName<TCategory>( LambdaCondition(), Format, Forward<ArgTypes>(Args)... );\
+        }\
     }
 #else
-#define UNLOG_DECLARE_CATEGORY_LOG_FUNCTION_CONDITIONALS( CategoryPicker, TargetOptions, FunctionName, VerbosityName, IsPrintf ) \
+#define UNLOG_DECLARE_CATEGORY_LOG_FUNCTION_CONDITIONALS( CategoryPicker, TargetOptions, FilterOptions, CompileTimeVerbosity, FunctionName, VerbosityName, IsPrintf ) \
     template< typename... TemplateArgs,typename... TArgs > \
-    FORCEINLINE static void FunctionName(TArgs... Args){}
+    FORCEINLINE static void FunctionName(TArgs&&... Args){}
 #endif // UNLOG_ENABLED
 
-#define UNLOG_DECLARE_CATEGORY_LOG_FUNCTION( CategoryPicker, TargetOptions, FunctionName, VerbosityName )\
-    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION_CONDITIONALS( CategoryPicker, TargetOptions, FunctionName, VerbosityName, false )\
-    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION_CONDITIONALS( CategoryPicker, TargetOptions, FunctionName##f, VerbosityName, true )
+#define UNLOG_DECLARE_CATEGORY_LOG_FUNCTION( CategoryPicker, TargetOptions, FilterOptions, CompileTimeVerbosity, FunctionName, VerbosityName )\
+    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION_CONDITIONALS( CategoryPicker, TargetOptions, FilterOptions, CompileTimeVerbosity, FunctionName, VerbosityName, false )\
+    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION_CONDITIONALS( CategoryPicker, TargetOptions, FilterOptions, CompileTimeVerbosity, FunctionName##f, VerbosityName, true )
 
 // ------------------------------------------------------------------------------------
 // Categories
@@ -84,13 +109,42 @@ class UnlogCategoryBase
 {
 private:
     FName CategoryName;
-    ELogVerbosity::Type Verbosity;
+
+    // Relaxed since it's only a filter, a log racing with a change can go either way
+    std::atomic<ELogVerbosity::Type> Verbosity;
+
+    uint32 Id;
+
+    static FCriticalSection& GetNamesLock()
+    {
+        static FCriticalSection Lock;
+        return Lock;
+    }
+
+    static TArray<FName>& GetNames()
+    {
+        static TArray<FName> Names;
+        return Names;
+    }
+
+    static uint32 AllocateId(const FName& Name)
+    {
+        FScopeLock Lock(&GetNamesLock());
+        return GetNames().Add(Name);
+    }
 
 public:
 
     UnlogCategoryBase(const FName& InName, ELogVerbosity::Type InVerbosity)
         : CategoryName(InName)
         , Verbosity(InVerbosity)
+        , Id(AllocateId(InName))
+    {}
+
+    UnlogCategoryBase(const UnlogCategoryBase& Other)
+        : CategoryName(Other.CategoryName)
+        , Verbosity(Other.GetVerbosity())
+        , Id(Other.Id)
     {}
 
     const FName& GetName() const
@@ -98,9 +152,31 @@ public:
         return CategoryName;
     }
 
-    ELogVerbosity::Type GetVerbosity() const
+    // Small number unique to this category for the app's execution, handy for compact storage
+    uint32 GetId() const
+    {
+        return Id;
+    }
+
+    // Name of the category given the id, or None if no category has that id yet
+    static FName FindName(uint32 InId)
+    {
+        FScopeLock Lock(&GetNamesLock());
+        return GetNames().IsValidIndex(InId) ? GetNames()[InId] : FName();
+    }
+
+    FORCEINLINE ELogVerbosity::Type GetVerbosity() const
+    {
+        return Verbosity.load(std::memory_order_relaxed);
+    }
+
+    /**
+    * Changes which messages this category lets through, can be called from any thread at any time.
+    * e.g: MyCategory::Static().SetVerbosity( ELogVerbosity::Verbose );
+    */
+    void SetVerbosity(ELogVerbosity::Type InVerbosity)
     {
-        return Verbosity;
+        Verbosity.store(InVerbosity, std::memory_order_relaxed);
     }
 };
 
@@ -150,7 +226,21 @@ friend class UnlogCategoryCRTP< CategoryName >;\
     UNLOG_CATEGORY_PUSH(CategoryName)
 
 #else
-#define UNLOG_CATEGORY( CategoryName ) class CategoryName {};
+// Keeps runtime category calls (e.g SetVerbosity) compiling when logging is compiled out
+template<typename TCategory>
+class UnlogCompiledOutCategory
+{
+public:
+    static TCategory& Static()
+    {
+        static TCategory Type;
+        return Type;
+    }
+
+    void SetVerbosity(ELogVerbosity::Type InVerbosity) {}
+};
+
+#define UNLOG_CATEGORY( CategoryName ) class CategoryName : public UnlogCompiledOutCategory< CategoryName > {};
 #define UNLOG_CATEGORY_PUSH( CategoryName ) UNLOG_COMPILED_OUT
 #define UNLOG_CATEGORY_SCOPED( CategoryName ) UNLOG_CATEGORY( CategoryName )
 #endif
@@ -166,7 +256,7 @@ class UnlogRuntimeTargetBase
 {
 public:
     virtual ~UnlogRuntimeTargetBase() {}
-    virtual void ProcessLog(const FName& Category, ELogVerbosity::Type Verbosity, const FString& Message) = 0;
+    virtual void ProcessLog(const FName& Category, ELogVerbosity::Type Verbosity, FStringView Message) = 0;
 };
 
 struct UnlogRuntimeSettingsBase
@@ -342,303 +432,3478 @@ private:
 #endif // WITH_EDITOR && UNLOG_ENABLED
 
 // ------------------------------------------------------------------------------------
-// Unlog runtime
+// Format strings
+//
+// Numbered format strings (e.g "{0} took {1}ms") are split into literal spans and
+// argument slots ahead of time so rendering a message is just a sequence of appends.
+//
+// Formats passed to the UNLOG macros are parsed at compile time into a static owned
+// by the call site. Formats passed to the logging functions are parsed on every call:
+// the function can't tell a literal from a buffer whose contents change between calls,
+// char formats are also converted to TCHAR into a stack buffer each time.
 // ------------------------------------------------------------------------------------
-#if UNLOG_ENABLED
-class Unlogger
+
+// A literal span of the format string, optionally followed by an argument slot
+struct FUnlogFormatSegment
 {
-private:
-    // Settings should never be destroyed since they are statically created
-    UnlogRuntimeSettingsBase* Settings;
+    int32 LiteralStart;
+    int32 LiteralLength;
+
+    // Argument to output after the literal, INDEX_NONE if the segment is just a literal
+    int32 ArgIndex;
+
+    // Length of the "{N}" token so it can be output verbatim when there's no matching argument
+    int32 TokenLength;
+};
 
-    // Pushed categories temporarily override the default category, usually during a certain scope
-    TArray<UnlogCategoryBase*> PushedCategories;
+// Type of each encoded argument, see FUnlogArgWriter
+enum class EUnlogArgType : uint8
+{
+    // Followed by an int64
+    Signed,
+    // Followed by a uint64
+    Unsigned,
+    // Followed by a double
+    Double,
+    // Followed by a uint16 length and that many TCHARs
+    String,
+    // Followed by a uint16 length and that many ANSI characters
+    AnsiString,
+    // Followed by a uint16 length and that many TCHARs, names the argument right after it
+    FieldName,
+    // Followed by a uint8, 0 or 1
+    Bool,
+};
 
+/**
+* Encodes arguments as typed values into a fixed buffer, for targets that keep them unformatted.
+* Each argument is an EUnlogArgType byte followed by its value, unaligned and in native byte order.
+* Strings are cut short when they don't fit, any other argument that doesn't fit is left out along
+* with the ones after it.
+*/
+class FUnlogArgWriter
+{
 public:
+    FUnlogArgWriter(uint8* InData, int32 InCapacity)
+        : Data(InData)
+        , Capacity(InCapacity)
+        , Size(0)
+        , bIsFull(false)
+    {}
 
-    static Unlogger& Get()
+    // Bytes written so far
+    int32 Num() const
     {
-        static Unlogger Logger = CreateLogger();
-        return Logger;
+        return Size;
     }
 
-    static Unlogger CreateLogger()
+    void WriteSigned(int64 Value)
     {
-        // Start with default settings
-        Unlogger Logger;
-        Logger.ApplyRuntimeSettingsInternal<UnlogDefaultRuntimeSettings>();
-
-#if WITH_EDITOR
-        static const FTelemetryDispatcher TelemetryDispatcher = FTelemetryDispatcher();
-#endif
-        return Logger;
+        WriteValue(EUnlogArgType::Signed, Value);
     }
 
-    template< typename TSettings >
-    static void ApplyRuntimeSettings()
+    void WriteUnsigned(uint64 Value)
     {
-        Unlogger::Get().ApplyRuntimeSettingsInternal<TSettings>();
+        WriteValue(EUnlogArgType::Unsigned, Value);
     }
 
-    template< typename TSettings >
-    void ApplyRuntimeSettingsInternal()
+    void WriteDouble(double Value)
     {
-        Settings = &TSettings::Static();
+        WriteValue(EUnlogArgType::Double, Value);
     }
 
-    void PushCategory(UnlogCategoryBase& Category)
+    void WriteBool(bool Value)
     {
-        PushedCategories.Push(&Category);
+        WriteValue(EUnlogArgType::Bool, (uint8)Value);
     }
 
-    void PopCategory()
+    void WriteString(const TCHAR* Chars, int32 Length)
     {
-        check(PushedCategories.Num() > 0);
-        PushedCategories.Pop();
+        WriteChars(EUnlogArgType::String, Chars, Length);
     }
 
-    FORCEINLINE static FString StringFormat(const TCHAR* Format, const FStringFormatOrderedArguments& Args)
+    void WriteAnsiString(const ANSICHAR* Chars, int32 Length)
     {
-        return FString::Format(Format, Args);
+        WriteChars(EUnlogArgType::AnsiString, Chars, Length);
     }
 
-    FORCEINLINE static FString StringFormat(const char* Format, const FStringFormatOrderedArguments& Args)
+    void WriteFieldName(const TCHAR* Chars, int32 Length)
     {
-        return FString::Format( UTF8_TO_TCHAR(Format), Args);
+        WriteChars(EUnlogArgType::FieldName, Chars, Length);
     }
 
-
-    template<typename CategoryPicker>
-    FORCEINLINE const UnlogCategoryBase& PickCategory()
+private:
+    template< typename T >
+    void WriteValue(EUnlogArgType Type, const T& Value)
     {
-        UnlogCategoryBase* SelectedCategory = PushedCategories.Num() > 0 ? PushedCategories.Last() : nullptr;
-
-        CategoryPicker::PickCategory(SelectedCategory);
+        if (bIsFull || Size + 1 + (int32)sizeof(T) > Capacity)
+        {
+            bIsFull = true;
+            return;
+        }
 
-        check(SelectedCategory);
-        return *SelectedCategory;
+        Data[Size] = (uint8)Type;
+        FMemory::Memcpy(Data + Size + 1, &Value, sizeof(T));
+        Size += 1 + sizeof(T);
     }
 
-    // Use ordered arguments format
-    template<
-        typename FormatOptions,
-        typename FMT,
-        typename... ArgTypes >
-    FORCEINLINE typename TEnableIf<!FormatOptions::IsPrintfFormat, FString>::Type  ProcessFormatString(const FMT& Format, ArgTypes... Args)
+    template< typename CharType >
+    void WriteChars(EUnlogArgType Type, const CharType* Chars, int32 Length)
     {
-        static_assert(TAnd<TIsConstructible<FStringFormatArg, ArgTypes>...>::Value, "Invalid argument type passed to UnlogPrivateImpl");
-        return Unlogger::StringFormat( Format, FStringFormatOrderedArguments({ Args... }) );
-    }
+        constexpr int32 HeaderSize = 1 + sizeof(uint16);
+        if (bIsFull || Size + HeaderSize > Capacity)
+        {
+            bIsFull = true;
+            return;
+        }
 
-    // Use Printf format
-    template<
-        typename FormatOptions,
-        typename FMT,
-        typename... ArgTypes >
-    FORCEINLINE typename TEnableIf<FormatOptions::IsPrintfFormat, FString>::Type ProcessFormatString(const FMT& Format, ArgTypes... Args)
-    {
-        static_assert(!TIsArrayOrRefOfType<FMT, char>::Value, "Unlog's printf style functions only support text wrapped by TEXT()");
-        FString Result = FString::Printf(Format, Args...);
-        return Result;
+        const uint16 Written = (uint16)FMath::Min<int32>(FMath::Min<int32>(Length, MAX_uint16), (Capacity - Size - HeaderSize) / sizeof(CharType));
+        Data[Size] = (uint8)Type;
+        FMemory::Memcpy(Data + Size + 1, &Written, sizeof(uint16));
+        FMemory::Memcpy(Data + Size + HeaderSize, Chars, Written * sizeof(CharType));
+        Size += HeaderSize + Written * sizeof(CharType);
+        bIsFull = Written < Length;
     }
 
-    template<typename StaticConfiguration, typename FMT, typename... ArgTypes>
-    void UnlogPrivateImpl(const FMT& Format, ELogVerbosity::Type Verbosity, ArgTypes... Args)
+    uint8* Data;
+    int32 Capacity;
+    int32 Size;
+    bool bIsFull;
+};
+
+// Type erased reference to a log argument, letting it be formatted in place
+struct FUnlogFormatArg
+{
+    const void* Value;
+    void (*AppendTo)(FStringBuilderBase& Out, const void* Value);
+    void (*EncodeTo)(FUnlogArgWriter& Out, const void* Value);
+
+    // Set for arguments passed as fields, see UNLOG_FIELD
+    const TCHAR* FieldName;
+};
+
+/**
+* An argument along with its name, see UNLOG_FIELD.
+* Fields are appended to the text as Name=Value and keep their name when encoded, so targets
+* serializing the arguments (e.g Target::JsonFile) don't have to parse them back out of the text.
+*/
+template< typename T >
+struct TUnlogField
+{
+    const TCHAR* Name;
+    const T& Value;
+};
+
+template< typename T >
+struct TIsUnlogField
+{
+    static constexpr bool Value = false;
+};
+
+template< typename T >
+struct TIsUnlogField< TUnlogField<T> >
+{
+    static constexpr bool Value = true;
+};
+
+// The type of an argument's value, unwrapping fields
+template< typename T >
+struct TUnlogFieldValue
+{
+    using Type = T;
+};
+
+template< typename T >
+struct TUnlogFieldValue< TUnlogField<T> >
+{
+    using Type = T;
+};
+
+/**
+* Passes a value as a field named after the expression.
+* e.g: Unlog::Log("Spawned", UNLOG_FIELD(ActorName), UNLOG_FIELD(Health)) logs "Spawned ActorName=Bob Health=100"
+*/
+#define UNLOG_FIELD( Value ) UnlogFormat::MakeField( TEXT( #Value ), Value )
+
+// Same as UNLOG_FIELD with an explicit name, e.g: UNLOG_NAMED_FIELD( Health, Actor->GetHealth() )
+#define UNLOG_NAMED_FIELD( Name, Value ) UnlogFormat::MakeField( TEXT( #Name ), Value )
+
+namespace UnlogFormat
+{
+    /**
+    * Splits Format into segments, "{N}" tokens become argument slots and everything else is kept verbatim.
+    * Returns the number of segments written to OutSegments or INDEX_NONE if more than MaxSegments are needed.
+    * Passing a null OutSegments just counts the segments.
+    */
+    template< typename CharType >
+    constexpr int32 ParseSegments(const CharType* Format, int32 Length, FUnlogFormatSegment* OutSegments, int32 MaxSegments)
     {
-        const auto& Category = PickCategory< typename StaticConfiguration::CategoryPicker>();
-        FName CategoryName = Category.GetName();
+        int32 NumSegments = 0;
+        int32 LiteralStart = 0;
+        int32 Cursor = 0;
 
-        if (Verbosity <= Category.GetVerbosity() && Verbosity != ELogVerbosity::NoLogging)
+        while (Cursor < Length)
         {
-            FString Result = ProcessFormatString<typename StaticConfiguration::FormatOptions>(Format, Args...);
+            if (Format[Cursor] == '{')
+            {
+                int32 TokenEnd = Cursor + 1;
+                int32 Index = 0;
+                while (TokenEnd < Length && Format[TokenEnd] >= '0' && Format[TokenEnd] <= '9')
+                {
+                    // Saturate instead of overflowing, the index will be out of range anyway
+                    Index = Index < 100000 ? Index * 10 + (Format[TokenEnd] - '0') : Index;
+                    ++TokenEnd;
+                }
 
-            // Execute all static targets
-            StaticConfiguration::TargetOptions::Call(Category, Verbosity, Result);
+                if (TokenEnd > Cursor + 1 && TokenEnd < Length && Format[TokenEnd] == '}')
+                {
+                    if (OutSegments)
+                    {
+                        if (NumSegments == MaxSegments)
+                        {
+                            return INDEX_NONE;
+                        }
+
+                        FUnlogFormatSegment& Segment = OutSegments[NumSegments];
+                        Segment.LiteralStart = LiteralStart;
+                        Segment.LiteralLength = Cursor - LiteralStart;
+                        Segment.ArgIndex = Index;
+                        Segment.TokenLength = TokenEnd + 1 - Cursor;
+                    }
+                    ++NumSegments;
+
+                    Cursor = TokenEnd + 1;
+                    LiteralStart = Cursor;
+                    continue;
+                }
+            }
+
+            ++Cursor;
+        }
+
+        if (LiteralStart < Length)
+        {
+            if (OutSegments)
+            {
+                if (NumSegments == MaxSegments)
+                {
+                    return INDEX_NONE;
+                }
+
+                FUnlogFormatSegment& Segment = OutSegments[NumSegments];
+                Segment.LiteralStart = LiteralStart;
+                Segment.LiteralLength = Length - LiteralStart;
+                Segment.ArgIndex = INDEX_NONE;
+                Segment.TokenLength = 0;
+            }
+            ++NumSegments;
         }
+
+        return NumSegments;
     }
-};
-#endif // UNLOG_ENABLED
 
-#if UNLOG_ENABLED
-template< typename TCategory >
-struct FUnlogScopedCategory
-{
-    FUnlogScopedCategory()
+    // Upper bound of segments a format of the given length can be split into; the shortest argument token is "{0}"
+    constexpr int32 MaxSegmentsForLength(int32 Length)
     {
-        Unlogger::Get().PushCategory(TCategory::Static());
+        return Length / 3 + 1;
     }
+}
 
-    ~FUnlogScopedCategory()
+/**
+* Format string parsed at compile time.
+* Created by the UNLOG macros so each call site owns a constant initialized copy.
+*/
+template< typename CharType, int32 MaxSegments >
+struct TUnlogStaticFormat
+{
+    const CharType* Format;
+    int32 Length;
+    int32 NumSegments;
+    FUnlogFormatSegment Segments[MaxSegments];
+
+    constexpr TUnlogStaticFormat(const CharType* InFormat, int32 InLength)
+        : Format(InFormat)
+        , Length(InLength)
+        , NumSegments(0)
+        , Segments{}
     {
-        Unlogger::Get().PopCategory();
+        NumSegments = UnlogFormat::ParseSegments(Format, Length, Segments, MaxSegments);
     }
 };
-#endif
 
-// ------------------------------------------------------------------------------------
-// Contexts (Experimental)
-// 
-// Tracks when the program has entered a specific "context", able to be queried 
-// by another system later down the callstack to selectively exclude certain log calls
-// without creating a direct dependency between systems to query state.
-// 
-// e.g. Ignore logging a widget when part of the editor callstack
-// 
-// Could technically be repurposed to selectively run other code besides logging.
-// ------------------------------------------------------------------------------------
-template <typename ActualType>
-class UnlogContextBase
+namespace UnlogFormat
 {
-public:
-
-    UnlogContextBase(const FName& InName)
-        : ContextName(InName)
-        , Counter(0u)
-    {}
-
-    FORCEINLINE static ActualType& Static()
+    // Widens each character, which is how FString converts ANSI text
+    FORCEINLINE void AppendAnsi(FStringBuilderBase& Out, const ANSICHAR* String, int32 Length)
     {
-        static ActualType Type = ActualType::Construct();
-        return Type;
+        for (int32 Index = 0; Index < Length; ++Index)
+        {
+            Out.AppendChar((TCHAR)(uint8)String[Index]);
+        }
     }
 
-    FORCEINLINE const FName& GetName() const
+    // Writes the digits into a small stack buffer instead of going through LexToString's temporary FString
+    FORCEINLINE void AppendInteger(FStringBuilderBase& Out, uint64 Magnitude, bool bNegative)
     {
-        return ContextName;
+        constexpr int32 MaxDigits = 24;
+        TCHAR Digits[MaxDigits];
+        int32 Start = MaxDigits;
+        do
+        {
+            Digits[--Start] = TEXT('0') + (TCHAR)(Magnitude % 10);
+            Magnitude /= 10;
+        } while (Magnitude > 0);
+
+        if (bNegative)
+        {
+            Digits[--Start] = TEXT('-');
+        }
+
+        Out.Append(Digits + Start, MaxDigits - Start);
     }
 
-    FORCEINLINE void IncrementCounter()
+    // Appending arguments, mirroring how FStringFormatArg turns each type into text
+    FORCEINLINE void AppendArg(FStringBuilderBase& Out, const FString& Value)
     {
-        Counter++;
+        Out.Append(*Value, Value.Len());
     }
 
-    FORCEINLINE void DecrementCounter()
+    FORCEINLINE void AppendArg(FStringBuilderBase& Out, const FText& Value)
     {
-        check(Counter > 0u);
-        Counter--;
+        AppendArg(Out, Value.ToString());
     }
 
-    FORCEINLINE bool IsActive() const
+    FORCEINLINE void AppendArg(FStringBuilderBase& Out, const FName& Value)
     {
-        return Counter > 0u;
+        Value.AppendString(Out);
     }
 
-    template< typename Functor >
-    FORCEINLINE static void WhenActive(Functor Func)
+    FORCEINLINE void AppendArg(FStringBuilderBase& Out, const TCHAR* Value)
     {
-        if (ActualType::Static().IsActive())
+        if (Value)
         {
-            Func();
+            Out.Append(Value, FCString::Strlen(Value));
         }
     }
 
-    template< typename Functor >
-    FORCEINLINE static void WhenNotActive(Functor Func)
+    FORCEINLINE void AppendArg(FStringBuilderBase& Out, const ANSICHAR* Value)
     {
-        if (!ActualType::Static().IsActive())
+        if (Value)
         {
-            Func();
+            AppendAnsi(Out, Value, FCStringAnsi::Strlen(Value));
         }
     }
 
-private:
-    FName ContextName;
-    uint32 Counter;
-};
+    template< typename T >
+    FORCEINLINE typename TEnableIf<TIsIntegral<T>::Value || TIsEnum<T>::Value>::Type AppendArg(FStringBuilderBase& Out, const T Value)
+    {
+        const int64 SignedValue = (int64)Value;
+        const bool bNegative = (TIsSigned<T>::Value || TIsEnum<T>::Value) && SignedValue < 0;
 
-#define UNLOG_CONTEXT(ContextName) \
-class ContextName : public UnlogContextBase< ContextName > \
-{\
-public:\
-    using UnlogContextBase< ContextName >::UnlogContextBase; \
-    static ContextName Construct()\
-    {\
-        return ContextName( TEXT( #ContextName ) );\
-    }\
-};
+        // Negating as unsigned keeps INT64_MIN well defined
+        AppendInteger(Out, bNegative ? 0 - (uint64)SignedValue : (uint64)Value, bNegative);
+    }
 
-template <typename TContext >
-struct UnloggerScopedContextEntered
-{
-    UnloggerScopedContextEntered(bool InValue)
-        : Value(InValue)
+    template< typename T >
+    FORCEINLINE typename TEnableIf<TIsFloatingPoint<T>::Value>::Type AppendArg(FStringBuilderBase& Out, const T Value)
     {
-        if (Value)
-        {
-            TContext::Static().IncrementCounter();
-        }
+        Out.Appendf(TEXT("%f"), (double)Value);
     }
 
-    UnloggerScopedContextEntered()
-        : UnloggerScopedContextEntered(true)
-    {}
+    // Encoding arguments, keeping the same types AppendArg would turn into text
+    FORCEINLINE void EncodeArg(FUnlogArgWriter& Out, const FString& Value)
+    {
+        Out.WriteString(*Value, Value.Len());
+    }
 
-    ~UnloggerScopedContextEntered()
+    FORCEINLINE void EncodeArg(FUnlogArgWriter& Out, const FText& Value)
     {
-        if (Value)
-        {
-            TContext::Static().DecrementCounter();
-        }
+        EncodeArg(Out, Value.ToString());
     }
-private:
-    bool Value;
-};
 
-#define UNLOG_CONTEXT_ENTERED(ContextName, ...) \
-    UnloggerScopedContextEntered< ContextName > ScopedContext_##ContextName( __VA_ARGS__ )
+    FORCEINLINE void EncodeArg(FUnlogArgWriter& Out, const FName& Value)
+    {
+        TStringBuilder<128> Name;
+        Value.AppendString(Name);
+        Out.WriteString(Name.ToString(), Name.Len());
+    }
 
+    FORCEINLINE void EncodeArg(FUnlogArgWriter& Out, const TCHAR* Value)
+    {
+        Out.WriteString(Value, Value ? FCString::Strlen(Value) : 0);
+    }
+
+    FORCEINLINE void EncodeArg(FUnlogArgWriter& Out, const ANSICHAR* Value)
+    {
+        Out.WriteAnsiString(Value, Value ? FCStringAnsi::Strlen(Value) : 0);
+    }
+
+    // Formatted as 0 or 1 like any other integer, but kept apart so structured outputs can tell it's a boolean
+    FORCEINLINE void EncodeArg(FUnlogArgWriter& Out, const bool Value)
+    {
+        Out.WriteBool(Value);
+    }
+
+    template< typename T >
+    FORCEINLINE typename TEnableIf<TIsIntegral<T>::Value || TIsEnum<T>::Value>::Type EncodeArg(FUnlogArgWriter& Out, const T Value)
+    {
+        if (TIsSigned<T>::Value || TIsEnum<T>::Value)
+        {
+            Out.WriteSigned((int64)Value);
+        }
+        else
+        {
+            Out.WriteUnsigned((uint64)Value);
+        }
+    }
+
+    template< typename T >
+    FORCEINLINE typename TEnableIf<TIsFloatingPoint<T>::Value>::Type EncodeArg(FUnlogArgWriter& Out, const T Value)
+    {
+        Out.WriteDouble((double)Value);
+    }
+
+    // Whether there's an EncodeArg overload for T
+    template< typename T, typename = void >
+    struct TIsEncodable
+    {
+        static constexpr bool Value = false;
+    };
+
+    template< typename T >
+    struct TIsEncodable<T, decltype(EncodeArg(DeclVal<FUnlogArgWriter&>(), DeclVal<const T&>()))>
+    {
+        static constexpr bool Value = true;
+    };
+
+    template< typename T >
+    static void AppendErasedArg(FStringBuilderBase& Out, const void* Value)
+    {
+        AppendArg(Out, *static_cast<const T*>(Value));
+    }
+
+    template< typename T >
+    static typename TEnableIf<TIsEncodable<T>::Value>::Type EncodeErasedArg(FUnlogArgWriter& Out, const void* Value)
+    {
+        EncodeArg(Out, *static_cast<const T*>(Value));
+    }
+
+    // Types only AppendArg knows about are encoded as their text
+    template< typename T >
+    static typename TEnableIf<!TIsEncodable<T>::Value>::Type EncodeErasedArg(FUnlogArgWriter& Out, const void* Value)
+    {
+        TStringBuilder<128> Text;
+        AppendArg(Text, *static_cast<const T*>(Value));
+        Out.WriteString(Text.ToString(), Text.Len());
+    }
+
+    template< typename T >
+    FORCEINLINE FUnlogFormatArg MakeArg(const T& Value)
+    {
+        return FUnlogFormatArg{ &Value, &AppendErasedArg<T>, &EncodeErasedArg<T>, nullptr };
+    }
+
+    template< typename T >
+    FORCEINLINE FUnlogFormatArg MakeArg(const TUnlogField<T>& Field)
+    {
+        return FUnlogFormatArg{ &Field.Value, &AppendErasedArg<T>, &EncodeErasedArg<T>, Field.Name };
+    }
+
+    template< typename T >
+    FORCEINLINE TUnlogField<T> MakeField(const TCHAR* Name, const T& Value)
+    {
+        return TUnlogField<T>{ Name, Value };
+    }
+
+    // Appends the fields after the message, e.g " Name=Bob Health=100"
+    FORCEINLINE void AppendFields(FStringBuilderBase& Out, const FUnlogFormatArg* Args, int32 NumArgs)
+    {
+        for (int32 Index = 0; Index < NumArgs; ++Index)
+        {
+            if (Args[Index].FieldName)
+            {
+                Out.AppendChar(TEXT(' '));
+                Out.Append(Args[Index].FieldName, FCString::Strlen(Args[Index].FieldName));
+                Out.AppendChar(TEXT('='));
+                Args[Index].AppendTo(Out, Args[Index].Value);
+            }
+        }
+    }
+
+    // Whether there's an AppendArg overload able to format T
+    template< typename T, typename = void >
+    struct TIsFormattable
+    {
+        static constexpr bool Value = false;
+    };
+
+    template< typename T >
+    struct TIsFormattable<T, decltype(AppendArg(DeclVal<FStringBuilderBase&>(), DeclVal<const T&>()))>
+    {
+        static constexpr bool Value = true;
+    };
+
+    template< typename CharType >
+    FORCEINLINE void RenderSegments(FStringBuilderBase& Out, const CharType* Format, const FUnlogFormatSegment* Segments, int32 NumSegments, const FUnlogFormatArg* Args, int32 NumArgs)
+    {
+        for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
+        {
+            const FUnlogFormatSegment& Segment = Segments[SegmentIndex];
+            Out.Append(Format + Segment.LiteralStart, Segment.LiteralLength);
+
+            // Literal only segments use INDEX_NONE, checking for any negative index also keeps gcc's bounds analysis quiet
+            if (Segment.ArgIndex < 0)
+            {
+                continue;
+            }
+
+            if (Segment.ArgIndex < NumArgs)
+            {
+                Args[Segment.ArgIndex].AppendTo(Out, Args[Segment.ArgIndex].Value);
+            }
+            else
+            {
+                Out.Append(Format + Segment.LiteralStart + Segment.LiteralLength, Segment.TokenLength);
+            }
+        }
+    }
+
+    // Picks how a format is rendered based on its type
+    template< typename FMT >
+    struct TFormatRenderer
+    {
+        static_assert(sizeof(FMT) == 0, "Unsupported format type passed to Unlog, use a string literal or a TCHAR pointer");
+    };
+
+    // Pointers may point to text built at runtime, they're parsed on every call
+    template<>
+    struct TFormatRenderer<const TCHAR*>
+    {
+        FORCEINLINE static void Render(FStringBuilderBase& Out, const TCHAR* Format, const FUnlogFormatArg* Args, int32 NumArgs)
+        {
+            constexpr int32 NumInlineSegments = 16;
+            const int32 Length = FCString::Strlen(Format);
+
+            FUnlogFormatSegment InlineSegments[NumInlineSegments];
+            const int32 NumSegments = ParseSegments(Format, Length, InlineSegments, NumInlineSegments);
+            if (NumSegments != INDEX_NONE)
+            {
+                RenderSegments(Out, Format, InlineSegments, NumSegments, Args, NumArgs);
+                return;
+            }
+
+            // Only formats with an unusual amount of arguments need to allocate their segments
+            TArray<FUnlogFormatSegment> Segments;
+            Segments.SetNum(MaxSegmentsForLength(Length));
+            Segments.SetNum(ParseSegments(Format, Length, Segments.GetData(), Segments.Num()));
+            RenderSegments(Out, Format, Segments.GetData(), Segments.Num(), Args, NumArgs);
+        }
+    };
+
+    template<>
+    struct TFormatRenderer<TCHAR*> : TFormatRenderer<const TCHAR*> {};
+
+    // Converted into an inline buffer, only formats too long for it allocate
+    template<>
+    struct TFormatRenderer<const ANSICHAR*>
+    {
+        FORCEINLINE static void Render(FStringBuilderBase& Out, const ANSICHAR* Format, const FUnlogFormatArg* Args, int32 NumArgs)
+        {
+            const FUTF8ToTCHAR Converted(Format);
+            TFormatRenderer<const TCHAR*>::Render(Out, Converted.Get(), Args, NumArgs);
+        }
+    };
+
+    template<>
+    struct TFormatRenderer<ANSICHAR*> : TFormatRenderer<const ANSICHAR*> {};
+
+    // Arrays are rendered from a parsed copy kept per format key, see TUnlogParsedFormat
+
+    template< int32 MaxSegments >
+    struct TFormatRenderer<TUnlogStaticFormat<TCHAR, MaxSegments>>
+    {
+        FORCEINLINE static void Render(FStringBuilderBase& Out, const TUnlogStaticFormat<TCHAR, MaxSegments>& Format, const FUnlogFormatArg* Args, int32 NumArgs)
+        {
+            RenderSegments(Out, Format.Format, Format.Segments, Format.NumSegments, Args, NumArgs);
+        }
+    };
+
+    template< typename FMT >
+    FORCEINLINE void Render(FStringBuilderBase& Out, const FMT& Format, const FUnlogFormatArg* Args, int32 NumArgs)
+    {
+        TFormatRenderer<FMT>::Render(Out, Format, Args, NumArgs);
+    }
+
+    // Formats are identified by their own address (literals, static formats). Pointer formats are usually built at
+    // runtime, keying them by the text they point to would track a new format every time its memory is reused
+    template< typename FMT >
+    struct TFormatKey
+    {
+        static FORCEINLINE const void* Get(const FMT& Format)
+        {
+            return &Format;
+        }
+    };
+
+    template< typename CharType >
+    struct TFormatKey<CharType*>
+    {
+        static FORCEINLINE const void* Get(CharType* Format)
+        {
+            return nullptr;
+        }
+    };
+
+    // Address identifying a format, stable per call site when using literals or the macros. Null for pointer formats
+    template< typename FMT >
+    FORCEINLINE const void* GetFormatKey(const FMT& Format)
+    {
+        return TFormatKey<FMT>::Get(Format);
+    }
+
+    template< typename CharType, int32 N >
+    constexpr int32 CountSegments(const CharType(&Format)[N])
+    {
+        return ParseSegments<CharType>(Format, N - 1, nullptr, 0);
+    }
+
+    /**
+    * Parses a literal at compile time, used by the macros to give each call site its own static format.
+    * NumSegments should come from CountSegments so the static only takes the space it needs.
+    */
+    template< int32 NumSegments, typename CharType, int32 N >
+    constexpr TUnlogStaticFormat<CharType, (NumSegments > 0 ? NumSegments : 1)> ParseStatic(const CharType(&Format)[N])
+    {
+        return TUnlogStaticFormat<CharType, (NumSegments > 0 ? NumSegments : 1)>(Format, N - 1);
+    }
+}
+
+// An argument read back by FUnlogArgReader
+struct FUnlogDecodedArg
+{
+    EUnlogArgType Type = EUnlogArgType::Signed;
+
+    // Empty unless the argument was passed as a field
+    FString Name;
+
+    // Only the one matching Type is set, ANSI strings are widened into String
+    int64 Signed = 0;
+    uint64 Unsigned = 0;
+    double Double = 0.0;
+    bool Bool = false;
+    FString String;
+
+    // Outputs the value as the same text it'd have been formatted into
+    void AppendValue(FStringBuilderBase& Out) const
+    {
+        switch (Type)
+        {
+        case EUnlogArgType::Signed:
+            UnlogFormat::AppendArg(Out, Signed);
+            break;
+        case EUnlogArgType::Unsigned:
+            UnlogFormat::AppendArg(Out, Unsigned);
+            break;
+        case EUnlogArgType::Double:
+            UnlogFormat::AppendArg(Out, Double);
+            break;
+        case EUnlogArgType::Bool:
+            UnlogFormat::AppendArg(Out, Bool);
+            break;
+        default:
+            Out.Append(*String, String.Len());
+            break;
+        }
+    }
+};
+
+/**
+* Reads back arguments encoded by FUnlogArgWriter, e.g to format trace events offline.
+* Values keep their type and fields their name, so tools can filter or aggregate on them.
+*/
+struct FUnlogArgReader
+{
+    // Returns false if the data is malformed, OutArgs keeps the arguments decoded until then
+    static bool Decode(const uint8* Data, int32 Size, TArray<FUnlogDecodedArg>& OutArgs)
+    {
+        FString PendingName;
+        int32 Offset = 0;
+        while (Offset < Size)
+        {
+            FUnlogDecodedArg Arg;
+            Arg.Type = (EUnlogArgType)Data[Offset++];
+
+            bool bIsValid = false;
+            switch (Arg.Type)
+            {
+            case EUnlogArgType::Signed:
+                bIsValid = Read(Data, Size, Offset, Arg.Signed);
+                break;
+            case EUnlogArgType::Unsigned:
+                bIsValid = Read(Data, Size, Offset, Arg.Unsigned);
+                break;
+            case EUnlogArgType::Double:
+                bIsValid = Read(Data, Size, Offset, Arg.Double);
+                break;
+            case EUnlogArgType::Bool:
+            {
+                uint8 Value = 0;
+                bIsValid = Read(Data, Size, Offset, Value);
+                Arg.Bool = Value != 0;
+                break;
+            }
+            case EUnlogArgType::String:
+            case EUnlogArgType::FieldName:
+            {
+                TArray<TCHAR> Chars;
+                bIsValid = ReadChars(Data, Size, Offset, Chars);
+                Arg.String = FString(Chars.Num(), Chars.GetData());
+                break;
+            }
+            case EUnlogArgType::AnsiString:
+            {
+                TArray<ANSICHAR> Chars;
+                bIsValid = ReadChars(Data, Size, Offset, Chars);
+
+                TStringBuilder<128> Text;
+                UnlogFormat::AppendAnsi(Text, Chars.GetData(), Chars.Num());
+                Arg.String = FString(Text.Len(), Text.ToString());
+                Arg.Type = EUnlogArgType::String;
+                break;
+            }
+            default:
+                break;
+            }
+
+            if (!bIsValid)
+            {
+                return false;
+            }
+
+            // Names precede the value they belong to, a name left at the end means its value didn't fit
+            if (Arg.Type == EUnlogArgType::FieldName)
+            {
+                PendingName = MoveTemp(Arg.String);
+                continue;
+            }
+
+            Arg.Name = MoveTemp(PendingName);
+            PendingName = FString();
+            OutArgs.Add(MoveTemp(Arg));
+        }
+        return true;
+    }
+
+    // Renders Format with the encoded arguments, as if they had been passed to the logging call
+    static void Render(FStringBuilderBase& Out, const TCHAR* Format, const uint8* Data, int32 Size)
+    {
+        TArray<FUnlogDecodedArg> Args;
+        Decode(Data, Size, Args);
+
+        TArray<FString> Values;
+        for (const FUnlogDecodedArg& Arg : Args)
+        {
+            TStringBuilder<128> Text;
+            Arg.AppendValue(Text);
+            Values.Add(FString(Text.Len(), Text.ToString()));
+        }
+
+        // Made once Values is complete so the arguments don't point into memory that moved
+        TArray<FUnlogFormatArg> FormatArgs;
+        for (int32 Index = 0; Index < Args.Num(); ++Index)
+        {
+            FormatArgs.Add(Args[Index].Name.IsEmpty() ? UnlogFormat::MakeArg(Values[Index]) : UnlogFormat::MakeArg(UnlogFormat::MakeField(*Args[Index].Name, Values[Index])));
+        }
+
+        UnlogFormat::Render(Out, Format, FormatArgs.GetData(), FormatArgs.Num());
+        UnlogFormat::AppendFields(Out, FormatArgs.GetData(), FormatArgs.Num());
+    }
+
+private:
+    template< typename T >
+    static bool Read(const uint8* Data, int32 Size, int32& Offset, T& OutValue)
+    {
+        if (Offset + (int32)sizeof(T) > Size)
+        {
+            return false;
+        }
+
+        FMemory::Memcpy(&OutValue, Data + Offset, sizeof(T));
+        Offset += sizeof(T);
+        return true;
+    }
+
+    template< typename CharType >
+    static bool ReadChars(const uint8* Data, int32 Size, int32& Offset, TArray<CharType>& OutChars)
+    {
+        uint16 Length;
+        if (!Read(Data, Size, Offset, Length) || Offset + Length * (int32)sizeof(CharType) > Size)
+        {
+            return false;
+        }
+
+        // Copied out since the characters aren't aligned
+        OutChars.SetNum(Length);
+        FMemory::Memcpy(OutChars.GetData(), Data + Offset, Length * sizeof(CharType));
+        Offset += Length * sizeof(CharType);
+        return true;
+    }
+};
+
+// ------------------------------------------------------------------------------------
+// Message source
+// 
+// Additional information about where a message comes from. Targets opt in to receiving
+// it by declaring a Call overload taking it as first parameter, every other target keeps
+// the usual Call( Category, Verbosity, Message ).
+// 
+// Targets can also take the message unformatted by declaring
+// Call( Source, Category, Verbosity, const FUnlogMessageArgs& ). When every target of a
+// logger does, messages are never formatted, leaving it to the targets to encode the
+// arguments or to render the text only when they need it. These targets still need the
+// usual Call taking the message source, for the messages Unlog produces itself (e.g
+// rate limiting summaries) or when they're behind TAsync and TDeduplicate.
+// ------------------------------------------------------------------------------------
+
+struct FUnlogCallSite;
+
+struct FUnlogMessageSource
+{
+    // See UnlogFormat::GetFormatKey, null when unknown
+    const void* FormatKey = nullptr;
+
+    // See FUnlogCallSite, null when unknown
+    const FUnlogCallSite* CallSite = nullptr;
+};
+
+/**
+* A message along with its format and arguments, for targets taking the message unformatted.
+* Only valid for the duration of the call, same as the message view.
+*/
+struct FUnlogMessageArgs
+{
+    FUnlogMessageArgs()
+        : Args(nullptr)
+        , NumArgs(0)
+        , Format(nullptr)
+        , RenderFormat(nullptr)
+        , FieldsStart(0)
+        , bIsFormatted(false)
+    {}
+
+    template< typename FMT >
+    FUnlogMessageArgs(const FMT& InFormat, const FUnlogFormatArg* InArgs, int32 InNumArgs)
+        : Args(InArgs)
+        , NumArgs(InNumArgs)
+        , Format(&InFormat)
+        , RenderFormat(&RenderErasedFormat<FMT>)
+        , FieldsStart(0)
+        , bIsFormatted(false)
+    {}
+
+    // Only set when one of the targets needs the text, see Target::TNeedsMessage
+    bool IsFormatted() const
+    {
+        return bIsFormatted;
+    }
+
+    FStringView GetMessage() const
+    {
+        return Message;
+    }
+
+    // The part of the formatted message before the fields appended to it
+    FStringView GetMessageWithoutFields() const
+    {
+        return FStringView(Message.GetData(), FieldsStart);
+    }
+
+    // InFieldsStart is where the fields appended to the message begin, its length when there are none
+    void SetMessage(FStringView InMessage, int32 InFieldsStart)
+    {
+        Message = InMessage;
+        FieldsStart = InFieldsStart;
+        bIsFormatted = true;
+    }
+
+    // Outputs the message text, formatting it if it wasn't already
+    void Render(FStringBuilderBase& Out) const
+    {
+        if (bIsFormatted)
+        {
+            Out.Append(Message.GetData(), Message.Len());
+        }
+        else if (RenderFormat)
+        {
+            RenderFormat(Out, Format, Args, NumArgs);
+            UnlogFormat::AppendFields(Out, Args, NumArgs);
+        }
+    }
+
+    // Outputs the message text without the fields appended to it, for targets serializing the fields on their own
+    void RenderWithoutFields(FStringBuilderBase& Out) const
+    {
+        if (bIsFormatted)
+        {
+            Out.Append(Message.GetData(), FieldsStart);
+        }
+        else if (RenderFormat)
+        {
+            RenderFormat(Out, Format, Args, NumArgs);
+        }
+    }
+
+    // Writes the arguments into Out, returning how many bytes were written. See FUnlogArgWriter for the layout
+    int32 Encode(uint8* Out, int32 Capacity) const
+    {
+        FUnlogArgWriter Writer(Out, Capacity);
+        for (int32 Index = 0; Index < NumArgs; ++Index)
+        {
+            if (Args[Index].FieldName)
+            {
+                Writer.WriteFieldName(Args[Index].FieldName, FCString::Strlen(Args[Index].FieldName));
+            }
+            Args[Index].EncodeTo(Writer, Args[Index].Value);
+        }
+        return Writer.Num();
+    }
+
+    // Null for printf style formats, their messages are always formatted
+    const FUnlogFormatArg* Args;
+    int32 NumArgs;
+
+private:
+    template< typename FMT >
+    static void RenderErasedFormat(FStringBuilderBase& Out, const void* Format, const FUnlogFormatArg* Args, int32 NumArgs)
+    {
+        UnlogFormat::Render(Out, *static_cast<const FMT*>(Format), Args, NumArgs);
+    }
+
+    const void* Format;
+    void (*RenderFormat)(FStringBuilderBase& Out, const void* Format, const FUnlogFormatArg* Args, int32 NumArgs);
+    FStringView Message;
+    int32 FieldsStart;
+    bool bIsFormatted;
+};
+
+// Arguments of a logging call, type erased so they can be formatted or handed to the targets as they are
+template< bool IsPrintfFormat, int32 NumArgs >
+struct TUnlogFormatArgs
+{
+    // Trailing element avoids declaring a zero sized array when there are no arguments
+    FUnlogFormatArg Args[NumArgs + 1];
+
+    template< typename... ArgTypes >
+    explicit TUnlogFormatArgs(const ArgTypes&... InArgs)
+        : Args{ UnlogFormat::MakeArg(InArgs)..., FUnlogFormatArg{} }
+    {
+        static_assert(TAnd<UnlogFormat::TIsFormattable<typename TUnlogFieldValue<ArgTypes>::Type>...>::Value, "Invalid argument type passed to UnlogPrivateImpl");
+    }
+
+    template< typename FMT >
+    FUnlogMessageArgs MakeMessageArgs(const FMT& Format) const
+    {
+        return FUnlogMessageArgs(Format, Args, NumArgs);
+    }
+};
+
+// Printf style arguments are only ever formatted by Appendf
+template< int32 NumArgs >
+struct TUnlogFormatArgs<true, NumArgs>
+{
+    template< typename... ArgTypes >
+    explicit TUnlogFormatArgs(const ArgTypes&... InArgs)
+    {
+        static_assert(!TOr<TIsUnlogField<ArgTypes>...>::Value, "Fields can't be passed to Unlog's printf style functions, use a numbered format instead");
+    }
+
+    template< typename FMT >
+    FUnlogMessageArgs MakeMessageArgs(const FMT& Format) const
+    {
+        return FUnlogMessageArgs();
+    }
+};
+
+namespace Target
+{
+    // Whether TTarget declares a Call overload taking the message source
+    template< typename TTarget, typename = void >
+    struct TAcceptsSource
+    {
+        static constexpr bool Value = false;
+    };
+
+    template< typename TTarget >
+    struct TAcceptsSource<TTarget, decltype(TTarget::Call(DeclVal<const FUnlogMessageSource&>(), DeclVal<const UnlogCategoryBase&>(), ELogVerbosity::Log, DeclVal<FStringView>()))>
+    {
+        static constexpr bool Value = true;
+    };
+
+    // Calls any target, only passing the message source to the ones accepting it
+    template< typename TTarget >
+    FORCEINLINE typename TEnableIf<TAcceptsSource<TTarget>::Value>::Type CallTarget(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+    {
+        TTarget::Call(Source, Category, Verbosity, Message);
+    }
+
+    template< typename TTarget >
+    FORCEINLINE typename TEnableIf<!TAcceptsSource<TTarget>::Value>::Type CallTarget(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+    {
+        TTarget::Call(Category, Verbosity, Message);
+    }
+
+    // Whether TTarget declares a Call overload taking the message unformatted
+    template< typename TTarget, typename = void >
+    struct TAcceptsArgs
+    {
+        static constexpr bool Value = false;
+    };
+
+    template< typename TTarget >
+    struct TAcceptsArgs<TTarget, decltype(TTarget::Call(DeclVal<const FUnlogMessageSource&>(), DeclVal<const UnlogCategoryBase&>(), ELogVerbosity::Log, DeclVal<const FUnlogMessageArgs&>()))>
+    {
+        static constexpr bool Value = true;
+    };
+
+    // Whether messages have to be formatted before calling TTarget, see TMultiTarget for targets combining others
+    template< typename TTarget >
+    struct TNeedsMessage
+    {
+        static constexpr bool Value = !TAcceptsArgs<TTarget>::Value;
+    };
+
+    // Calls any target, formatted messages are expected unless none of the targets need them
+    template< typename TTarget >
+    FORCEINLINE typename TEnableIf<TAcceptsArgs<TTarget>::Value>::Type CallTarget(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FUnlogMessageArgs& Args)
+    {
+        TTarget::Call(Source, Category, Verbosity, Args);
+    }
+
+    template< typename TTarget >
+    FORCEINLINE typename TEnableIf<!TAcceptsArgs<TTarget>::Value>::Type CallTarget(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FUnlogMessageArgs& Args)
+    {
+        check(Args.IsFormatted());
+        CallTarget<TTarget>(Source, Category, Verbosity, Args.GetMessage());
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// Call sites
+// 
+// Logging statements written with the UNLOG and UN_LOG macros are described by an
+// FUnlogCallSite, a constant initialized descriptor owned by the statement, including its
+// file and line. Only the macros get call sites: calls through the logging functions
+// can't know where they were called from and their format may not outlive the call, so
+// they have no descriptor and are skipped by the listing, the switches and Trace's
+// per call site specs (runtime formats are traced as text instead).
+//
+// Call sites are registered the first time they're hit, getting a unique id and the
+// category they log to. Registered call sites can be listed with FUnlogCallSite::ForEach.
+// 
+// Each call site can also be switched off at runtime (see FUnlogCallSite::SetEnabled),
+// in which case the call stops right after checking a single byte.
+// ------------------------------------------------------------------------------------
+
+// Maximum number of call sites tracked by each per call site table (e.g rate limiting or sampling filters)
+#ifndef UNLOG_CALL_SITE_SLOTS
+#define UNLOG_CALL_SITE_SLOTS 4096
+#endif
+
+// Selects call sites to switch on or off, see FUnlogCallSite::SetEnabled
+struct FUnlogCallSiteQuery
+{
+    // Wildcard matched against the call site's file path (e.g "*/Sockets/*"), empty matches every file
+    FString File;
+
+    // 0 matches every line
+    int32 Line = 0;
+
+    // Wildcard matched against the call site's format (e.g "*timed out*"), empty matches every format
+    FString Format;
+};
+
+struct FUnlogCallSite
+{
+    // Where the call site is. Only the macros create call sites, calls through the logging functions have none
+    const ANSICHAR* File;
+    int32 Line;
+
+    // See UnlogFormat::GetFormatKey
+    const void* Format;
+
+    // Filled in when registering. Category is the one picked on the first call to get past the verbosity checks.
+    // Text is the literal the macro was given, never a string built at runtime, see UnlogFormat::GetText
+    const ANSICHAR* Function;
+    const TCHAR* Text;
+    const UnlogCategoryBase* Category;
+
+    constexpr FUnlogCallSite(const ANSICHAR* InFile = nullptr, int32 InLine = 0, const void* InFormat = nullptr)
+        : File(InFile)
+        , Line(InLine)
+        , Format(InFormat)
+        , Function(nullptr)
+        , Text(nullptr)
+        , Category(nullptr)
+        , bEnabled(true)
+        , Id(0)
+    {}
+
+    // Checked before doing anything else, relaxed since a call racing with a switch can go either way
+    FORCEINLINE bool IsEnabled() const
+    {
+        return bEnabled.load(std::memory_order_relaxed);
+    }
+
+    FORCEINLINE bool IsRegistered() const
+    {
+        return Id.load(std::memory_order_acquire) != 0;
+    }
+
+    // Unique for the app's execution and sequential starting at 1, 0 until registered
+    uint32 GetId() const
+    {
+        return Id.load(std::memory_order_acquire);
+    }
+
+    // Only the first call has any effect. InFormat is used when the call site didn't know its format upfront
+    void Register(const ANSICHAR* InFunction, const void* InFormat, const TCHAR* InText, const UnlogCategoryBase& InCategory)
+    {
+        FScopeLock Lock(&GetRegistryLock());
+        if (Id.load(std::memory_order_relaxed) != 0)
+        {
+            return;
+        }
+
+        Format = Format ? Format : InFormat;
+        Function = InFunction;
+        Text = InText;
+        Category = &InCategory;
+
+        // Call sites hit after being switched on or off follow the same switches
+        for (const TPair<FUnlogCallSiteQuery, bool>& Rule : GetRules())
+        {
+            if (Matches(Rule.Key))
+            {
+                bEnabled.store(Rule.Value, std::memory_order_relaxed);
+            }
+        }
+
+        TArray<FUnlogCallSite*>& Registry = GetRegistry();
+        Registry.Add(this);
+
+        // Released last, so anyone seeing the id also sees the rest
+        Id.store(Registry.Num(), std::memory_order_release);
+    }
+
+    /**
+    * Switches on or off every call site matching the query, including the ones that haven't been hit yet.
+    * Later calls take precedence, e.g disabling everything then enabling a few call sites back.
+    * Returns how many of the call sites hit so far were affected.
+    */
+    static int32 SetEnabled(const FUnlogCallSiteQuery& Query, bool bInEnabled)
+    {
+        FScopeLock Lock(&GetRegistryLock());
+        GetRules().Emplace(Query, bInEnabled);
+
+        int32 NumMatches = 0;
+        for (FUnlogCallSite* CallSite : GetRegistry())
+        {
+            if (CallSite->Matches(Query))
+            {
+                CallSite->bEnabled.store(bInEnabled, std::memory_order_relaxed);
+                ++NumMatches;
+            }
+        }
+        return NumMatches;
+    }
+
+    // Forgets every switch and turns all call sites back on
+    static void ResetEnabled()
+    {
+        FScopeLock Lock(&GetRegistryLock());
+        GetRules().Reset();
+
+        for (FUnlogCallSite* CallSite : GetRegistry())
+        {
+            CallSite->bEnabled.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    bool Matches(const FUnlogCallSiteQuery& Query) const
+    {
+        if (Query.Line != 0 && Query.Line != Line)
+        {
+            return false;
+        }
+
+        if (!Query.File.IsEmpty() && (!File || !FString(UTF8_TO_TCHAR(File)).MatchesWildcard(Query.File)))
+        {
+            return false;
+        }
+
+        return Query.Format.IsEmpty() || (Text && FString(Text).MatchesWildcard(Query.Format));
+    }
+
+    // Visits every registered call site, in registration order
+    static void ForEach(TFunctionRef<void(FUnlogCallSite&)> Visitor)
+    {
+        TArray<FUnlogCallSite*> CallSites;
+        {
+            FScopeLock Lock(&GetRegistryLock());
+            CallSites = GetRegistry();
+        }
+
+        for (FUnlogCallSite* CallSite : CallSites)
+        {
+            Visitor(*CallSite);
+        }
+    }
+
+private:
+    std::atomic<bool> bEnabled;
+    std::atomic<uint32> Id;
+
+    static FCriticalSection& GetRegistryLock()
+    {
+        static FCriticalSection RegistryLock;
+        return RegistryLock;
+    }
+
+    static TArray<FUnlogCallSite*>& GetRegistry()
+    {
+        static TArray<FUnlogCallSite*> Registry;
+        return Registry;
+    }
+
+    static TArray< TPair<FUnlogCallSiteQuery, bool> >& GetRules()
+    {
+        static TArray< TPair<FUnlogCallSiteQuery, bool> > Rules;
+        return Rules;
+    }
+};
+
+#if UNLOG_ENABLED
+/**
+* Lock-free table of per call site state keyed by format key, using open addressing with a bounded number of probes.
+* Entries are never removed since call sites live for the rest of the app's execution.
+* Each set of ScopeTypes gets its own table, e.g so loggers configured differently don't share their state.
+*/
+template< typename StateType, typename... ScopeTypes >
+class TUnlogCallSiteTable
+{
+private:
+    static constexpr int32 NumSlots = UNLOG_CALL_SITE_SLOTS;
+    static constexpr int32 MaxProbes = 16;
+    static_assert((NumSlots & (NumSlots - 1)) == 0, "UNLOG_CALL_SITE_SLOTS must be a power of two");
+
+    struct FEntry
+    {
+        const void* Key;
+        StateType State;
+
+        explicit FEntry(const void* InKey)
+            : Key(InKey)
+            , State()
+        {}
+    };
+
+    std::atomic<FEntry*> Slots[NumSlots];
+
+    TUnlogCallSiteTable()
+    {
+        for (auto& Slot : Slots)
+        {
+            Slot.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+public:
+
+    static TUnlogCallSiteTable& Get()
+    {
+        static TUnlogCallSiteTable Table;
+        return Table;
+    }
+
+    // Returns the state of the call site or nullptr if the table is full
+    StateType* FindOrAdd(const void* Key)
+    {
+        return FindOrAdd(Key, [] {});
+    }
+
+    // Same as above, calling OnAdded() on the thread adding the call site when it's new
+    template< typename FunctorType >
+    StateType* FindOrAdd(const void* Key, FunctorType&& OnAdded)
+    {
+        const uint32 Hash = PointerHash(Key);
+
+        for (int32 Probe = 0; Probe < MaxProbes; ++Probe)
+        {
+            std::atomic<FEntry*>& Slot = Slots[(Hash + Probe) & (NumSlots - 1)];
+            FEntry* Entry = Slot.load(std::memory_order_acquire);
+
+            if (Entry == nullptr)
+            {
+                FEntry* NewEntry = new FEntry(Key);
+                if (Slot.compare_exchange_strong(Entry, NewEntry, std::memory_order_acq_rel))
+                {
+                    OnAdded();
+                    return &NewEntry->State;
+                }
+
+                // Another thread claimed the slot first, Entry now holds its value
+                delete NewEntry;
+            }
+
+            if (Entry->Key == Key)
+            {
+                return &Entry->State;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Visits the state of every call site added so far
+    template< typename FunctorType >
+    void ForEach(FunctorType&& Functor)
+    {
+        for (std::atomic<FEntry*>& Slot : Slots)
+        {
+            if (FEntry* Entry = Slot.load(std::memory_order_acquire))
+            {
+                Functor(Entry->State);
+            }
+        }
+    }
+};
+
+/**
+* Parsed copy of a format array passed to the logging functions, made the first time the array is logged and kept
+* for the rest of the app's execution. Arrays may be literals or buffers filled at runtime, so every call checks the
+* array still holds the copied text before rendering from it, the ones whose text changed are parsed again.
+*/
+template< typename CharType >
+struct TUnlogParsedFormat
+{
+    // The format as it was first passed, compared against the array on every call
+    TArray<CharType> Source;
+
+    // Text the segments point into, widened for char formats
+    FString Text;
+
+    TArray<FUnlogFormatSegment> Segments;
+
+    TUnlogParsedFormat(const CharType* Format, int32 Length)
+        : Text(ToText(Format, Length))
+    {
+        Source.SetNum(Length);
+        FMemory::Memcpy(Source.GetData(), Format, Length * sizeof(CharType));
+
+        Segments.SetNum(UnlogFormat::MaxSegmentsForLength(Text.Len()));
+        Segments.SetNum(UnlogFormat::ParseSegments(*Text, Text.Len(), Segments.GetData(), Segments.Num()));
+    }
+
+    FORCEINLINE bool Matches(const CharType* Format, int32 Length) const
+    {
+        return Source.Num() == Length && FMemory::Memcmp(Source.GetData(), Format, Length * sizeof(CharType)) == 0;
+    }
+
+    // Returns the parsed copy of the format, or nullptr if it can't be used for this call (text changed, table full)
+    static const TUnlogParsedFormat* Find(const CharType* Format, int32 Length)
+    {
+        FSlot* Slot = TUnlogCallSiteTable<FSlot, CharType>::Get().FindOrAdd(Format);
+        if (Slot == nullptr)
+        {
+            return nullptr;
+        }
+
+        const TUnlogParsedFormat* Parsed = Slot->Parsed.load(std::memory_order_acquire);
+        if (Parsed == nullptr)
+        {
+            TUnlogParsedFormat* NewParsed = new TUnlogParsedFormat(Format, Length);
+            if (Slot->Parsed.compare_exchange_strong(Parsed, NewParsed, std::memory_order_acq_rel))
+            {
+                return NewParsed;
+            }
+
+            // Another thread parsed it first, Parsed now holds its copy
+            delete NewParsed;
+        }
+
+        return Parsed->Matches(Format, Length) ? Parsed : nullptr;
+    }
+
+private:
+    struct FSlot
+    {
+        std::atomic<const TUnlogParsedFormat*> Parsed{ nullptr };
+    };
+
+    static FString ToText(const TCHAR* Format, int32 Length)
+    {
+        return FString(Length, Format);
+    }
+
+    static FString ToText(const ANSICHAR* Format, int32 Length)
+    {
+        const FUTF8ToTCHAR Converted(Format);
+        return FString(Converted.Length(), Converted.Get());
+    }
+};
+
+namespace UnlogFormat
+{
+    template< typename CharType >
+    struct TArrayFormatRenderer
+    {
+        FORCEINLINE static void Render(FStringBuilderBase& Out, const CharType* Format, const FUnlogFormatArg* Args, int32 NumArgs)
+        {
+            const int32 Length = TCString<CharType>::Strlen(Format);
+            if (const TUnlogParsedFormat<CharType>* Parsed = TUnlogParsedFormat<CharType>::Find(Format, Length))
+            {
+                RenderSegments(Out, *Parsed->Text, Parsed->Segments.GetData(), Parsed->Segments.Num(), Args, NumArgs);
+                return;
+            }
+
+            TFormatRenderer<const CharType*>::Render(Out, Format, Args, NumArgs);
+        }
+    };
+
+    template< int32 N >
+    struct TFormatRenderer<TCHAR[N]> : TArrayFormatRenderer<TCHAR> {};
+
+    template< int32 N >
+    struct TFormatRenderer<ANSICHAR[N]> : TArrayFormatRenderer<ANSICHAR> {};
+}
+
+// Format passed by the macros, bundled with the call site it comes from
+template< typename FormatType >
+struct TUnlogSitedFormat
+{
+    FUnlogCallSite& CallSite;
+    const FormatType& Format;
+    const ANSICHAR* Function;
+};
+
+namespace UnlogFormat
+{
+    template< typename FormatType >
+    FORCEINLINE TUnlogSitedFormat<FormatType> MakeSited(FUnlogCallSite& CallSite, const FormatType& Format, const ANSICHAR* Function)
+    {
+        return TUnlogSitedFormat<FormatType>{ CallSite, Format, Function };
+    }
+
+    // The format to render, unwrapping the ones bundled with their call site
+    template< typename FMT >
+    FORCEINLINE const FMT& GetFormat(const FMT& Format)
+    {
+        return Format;
+    }
+
+    template< typename FormatType >
+    FORCEINLINE const FormatType& GetFormat(const TUnlogSitedFormat<FormatType>& Sited)
+    {
+        return Sited.Format;
+    }
+
+    // Format text of a call site, used to match it against queries. Only the literals wrapped by the macros have one,
+    // call sites keep the pointer for the rest of the app's execution
+    template< typename FMT >
+    FORCEINLINE const TCHAR* GetText(const FMT& Format)
+    {
+        return nullptr;
+    }
+
+    template< int32 N >
+    FORCEINLINE const TCHAR* GetText(const TCHAR(&Format)[N])
+    {
+        return Format;
+    }
+
+    template< int32 MaxSegments >
+    FORCEINLINE const TCHAR* GetText(const TUnlogStaticFormat<TCHAR, MaxSegments>& Format)
+    {
+        return Format.Format;
+    }
+
+    // Only call sites created by the macros can be switched off before reaching Unlogger, see UnlogPrivateImpl for the rest
+    template< typename FMT >
+    FORCEINLINE bool IsCallSiteEnabled(const FMT& Format)
+    {
+        return true;
+    }
+
+    template< typename FormatType >
+    FORCEINLINE bool IsCallSiteEnabled(const TUnlogSitedFormat<FormatType>& Sited)
+    {
+        return Sited.CallSite.IsEnabled();
+    }
+
+    // Only the macros describe their call site, formats passed to the logging functions may be built at runtime and don't outlive the call
+    template< typename FMT >
+    FORCEINLINE FUnlogCallSite* GetCallSite(const FMT& Format, const ANSICHAR*& OutFunction)
+    {
+        OutFunction = nullptr;
+        return nullptr;
+    }
+
+    template< typename FormatType >
+    FORCEINLINE FUnlogCallSite* GetCallSite(const TUnlogSitedFormat<FormatType>& Sited, const ANSICHAR*& OutFunction)
+    {
+        OutFunction = Sited.Function;
+        return &Sited.CallSite;
+    }
+}
+
+/**
+* Console commands switching call sites on and off, taking an optional query as arguments:
+* Unlog.CallSites.Disable file=*Sockets* line=120 format=*timed?out*
+* Arguments are split by spaces, use ? to match them in wildcards.
+*/
+class FUnlogCallSiteCommands
+{
+public:
+    FUnlogCallSiteCommands()
+        : ListCommand(TEXT("Unlog.CallSites.List"), TEXT("Lists the call sites hit so far, optionally filtered by file=, line= and format="),
+            FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FUnlogCallSiteCommands::List))
+        , EnableCommand(TEXT("Unlog.CallSites.Enable"), TEXT("Switches on the call sites matching file=, line= and format="),
+            FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FUnlogCallSiteCommands::Enable))
+        , DisableCommand(TEXT("Unlog.CallSites.Disable"), TEXT("Switches off the call sites matching file=, line= and format="),
+            FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FUnlogCallSiteCommands::Disable))
+        , ResetCommand(TEXT("Unlog.CallSites.Reset"), TEXT("Switches every call site back on"),
+            FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FUnlogCallSiteCommands::Reset))
+    {}
+
+private:
+    static FUnlogCallSiteQuery ParseQuery(const TArray<FString>& Args)
+    {
+        FUnlogCallSiteQuery Query;
+        for (const FString& Arg : Args)
+        {
+            FString Key;
+            FString Value;
+            if (!Arg.Split(TEXT("="), &Key, &Value))
+            {
+                continue;
+            }
+
+            if (Key == TEXT("file"))
+            {
+                Query.File = Value;
+            }
+            else if (Key == TEXT("line"))
+            {
+                Query.Line = FCString::Atoi(*Value);
+            }
+            else if (Key == TEXT("format"))
+            {
+                Query.Format = Value;
+            }
+        }
+        return Query;
+    }
+
+    static void List(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        const FUnlogCallSiteQuery Query = ParseQuery(Args);
+        FUnlogCallSite::ForEach([&Query, &Ar](FUnlogCallSite& CallSite)
+        {
+            if (CallSite.Matches(Query))
+            {
+                Ar.Logf(TEXT("#%u %s %s:%d %s"),
+                    CallSite.GetId(),
+                    CallSite.IsEnabled() ? TEXT("on ") : TEXT("off"),
+                    CallSite.File ? UTF8_TO_TCHAR(CallSite.File) : TEXT("<function>"),
+                    CallSite.Line,
+                    CallSite.Text ? CallSite.Text : TEXT(""));
+            }
+        });
+    }
+
+    static void Enable(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        Ar.Logf(TEXT("Switched on %d call sites"), FUnlogCallSite::SetEnabled(ParseQuery(Args), true));
+    }
+
+    static void Disable(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        Ar.Logf(TEXT("Switched off %d call sites"), FUnlogCallSite::SetEnabled(ParseQuery(Args), false));
+    }
+
+    static void Reset(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        FUnlogCallSite::ResetEnabled();
+    }
+
+    FAutoConsoleCommand ListCommand;
+    FAutoConsoleCommand EnableCommand;
+    FAutoConsoleCommand DisableCommand;
+    FAutoConsoleCommand ResetCommand;
+};
+#endif // UNLOG_ENABLED
+
+// ------------------------------------------------------------------------------------
+// Category stats
+//
+// Each category counts how many messages it emitted and filtered, how many bytes it
+// formatted and the cycles spent formatting versus running the targets. Counters live
+// per thread so logging threads never contend, and are summed up when collected:
+// FUnlogCategoryStats::Collect() or the Unlog.Categories.Stats console command.
+//
+// Only text formatted by the logger is counted as bytes, loggers whose targets take the
+// arguments unformatted (e.g Target::Trace) count none and their format time stays close
+// to zero. Whatever the targets encode or format themselves counts as target time.
+//
+// Calls switched off or compiled out by the logger aren't counted, they never reach the
+// runtime. Neither are calls rejected by the category's verbosity unless
+// UNLOG_CATEGORY_STATS_VERBOSITY is set, so rejecting them stays a single load.
+// Define UNLOG_CATEGORY_STATS as 0 to remove the counters altogether.
+// ------------------------------------------------------------------------------------
+
+#ifndef UNLOG_CATEGORY_STATS
+#define UNLOG_CATEGORY_STATS 1
+#endif
+
+// Also counts calls rejected by the category's verbosity as filtered, at the cost of a counter lookup per rejected call
+#ifndef UNLOG_CATEGORY_STATS_VERBOSITY
+#define UNLOG_CATEGORY_STATS_VERBOSITY 0
+#endif
+
+// Categories with a higher id aren't counted
+#ifndef UNLOG_CATEGORY_STATS_CAPACITY
+#define UNLOG_CATEGORY_STATS_CAPACITY 1024
+#endif
+
+#if UNLOG_ENABLED && UNLOG_CATEGORY_STATS
+// Counters of a category on a single thread, padded so two threads never share a cache line
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FUnlogCategoryCounters
+{
+    // Atomics so other threads can read them, but only the owning thread ever writes
+    std::atomic<uint64> NumEmitted;
+    std::atomic<uint64> NumFiltered;
+    std::atomic<uint64> NumFormattedBytes;
+    std::atomic<uint64> FormatCycles;
+    std::atomic<uint64> TargetCycles;
+
+    FUnlogCategoryCounters()
+        : NumEmitted(0)
+        , NumFiltered(0)
+        , NumFormattedBytes(0)
+        , FormatCycles(0)
+        , TargetCycles(0)
+    {}
+
+    // A plain load and store, much cheaper than an atomic increment
+    static FORCEINLINE void Add(std::atomic<uint64>& Counter, uint64 Value)
+    {
+        Counter.store(Counter.load(std::memory_order_relaxed) + Value, std::memory_order_relaxed);
+    }
+};
+
+/**
+* Every category's counters for a single thread, allocated in chunks the first time a category logs on it.
+* Blocks are kept after their thread exits so its counts remain part of the totals.
+*/
+class FUnlogThreadCounters
+{
+public:
+    static constexpr int32 ChunkSize = 16;
+    static constexpr int32 NumChunks = (UNLOG_CATEGORY_STATS_CAPACITY + ChunkSize - 1) / ChunkSize;
+
+    static FORCEINLINE FUnlogCategoryCounters& Find(const UnlogCategoryBase& Category)
+    {
+        static thread_local FUnlogThreadCounters* Counters = Create();
+        return Counters->FindOrAdd(Category.GetId());
+    }
+
+    template< typename FunctionType >
+    static void ForEach(const FunctionType& Function)
+    {
+        FScopeLock Lock(&GetRegistryLock());
+        for (FUnlogThreadCounters* Counters : GetRegistry())
+        {
+            for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+            {
+                FUnlogCategoryCounters* Chunk = Counters->Chunks[ChunkIndex].load(std::memory_order_acquire);
+                for (int32 Index = 0; Chunk && Index < ChunkSize; ++Index)
+                {
+                    Function(ChunkIndex * ChunkSize + Index, Chunk[Index]);
+                }
+            }
+        }
+    }
+
+private:
+    FUnlogThreadCounters()
+    {
+        for (std::atomic<FUnlogCategoryCounters*>& Chunk : Chunks)
+        {
+            Chunk.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    static FUnlogThreadCounters* Create()
+    {
+        // Aligned by hand, new only respects the alignment of padded types from C++17 onwards
+        FUnlogThreadCounters* Counters = new (FMemory::Malloc(sizeof(FUnlogThreadCounters), alignof(FUnlogThreadCounters))) FUnlogThreadCounters();
+        FScopeLock Lock(&GetRegistryLock());
+        GetRegistry().Add(Counters);
+        return Counters;
+    }
+
+    FORCEINLINE FUnlogCategoryCounters& FindOrAdd(uint32 CategoryId)
+    {
+        if (CategoryId >= (uint32)NumChunks * ChunkSize)
+        {
+            return Overflow;
+        }
+
+        std::atomic<FUnlogCategoryCounters*>& Chunk = Chunks[CategoryId / ChunkSize];
+        FUnlogCategoryCounters* Counters = Chunk.load(std::memory_order_relaxed);
+        if (!Counters)
+        {
+            Counters = static_cast<FUnlogCategoryCounters*>(FMemory::Malloc(sizeof(FUnlogCategoryCounters) * ChunkSize, alignof(FUnlogCategoryCounters)));
+            for (int32 Index = 0; Index < ChunkSize; ++Index)
+            {
+                new (&Counters[Index]) FUnlogCategoryCounters();
+            }
+            Chunk.store(Counters, std::memory_order_release);
+        }
+        return Counters[CategoryId % ChunkSize];
+    }
+
+    static FCriticalSection& GetRegistryLock()
+    {
+        static FCriticalSection Lock;
+        return Lock;
+    }
+
+    // Never destroyed along with the counters it points to, threads may still be logging during shutdown
+    static TArray<FUnlogThreadCounters*>& GetRegistry()
+    {
+        static TArray<FUnlogThreadCounters*>* Registry = new TArray<FUnlogThreadCounters*>();
+        return *Registry;
+    }
+
+    std::atomic<FUnlogCategoryCounters*> Chunks[NumChunks];
+
+    // Shared by the categories past the capacity, never collected
+    FUnlogCategoryCounters Overflow;
+};
+#endif // UNLOG_ENABLED && UNLOG_CATEGORY_STATS
+
+// Totals of a category across every thread
+struct FUnlogCategoryStats
+{
+    FName Category;
+    uint64 NumEmitted = 0;
+    uint64 NumFiltered = 0;
+    uint64 NumFormattedBytes = 0;
+    uint64 FormatCycles = 0;
+    uint64 TargetCycles = 0;
+
+    // Categories that logged since the last Reset, the most expensive first
+    static TArray<FUnlogCategoryStats> Collect()
+    {
+        TArray<FUnlogCategoryStats> Result;
+#if UNLOG_ENABLED && UNLOG_CATEGORY_STATS
+        TArray<FUnlogCategoryStats> Totals = Sum();
+
+        FScopeLock Lock(&GetBaselineLock());
+        const TArray<FUnlogCategoryStats>& Baseline = GetBaseline();
+        for (int32 Id = 0; Id < Totals.Num(); ++Id)
+        {
+            FUnlogCategoryStats Stats = Totals[Id];
+            if (Baseline.IsValidIndex(Id))
+            {
+                Stats.Subtract(Baseline[Id]);
+            }
+
+            if (Stats.NumEmitted + Stats.NumFiltered > 0)
+            {
+                Stats.Category = UnlogCategoryBase::FindName(Id);
+                Result.Add(Stats);
+            }
+        }
+
+        Result.Sort([](const FUnlogCategoryStats& A, const FUnlogCategoryStats& B)
+        {
+            return A.FormatCycles + A.TargetCycles > B.FormatCycles + B.TargetCycles;
+        });
+#endif
+        return Result;
+    }
+
+    // Starts counting from zero again, counters themselves are left untouched so logging threads never race with it
+    static void Reset()
+    {
+#if UNLOG_ENABLED && UNLOG_CATEGORY_STATS
+        TArray<FUnlogCategoryStats> Totals = Sum();
+
+        FScopeLock Lock(&GetBaselineLock());
+        GetBaseline() = MoveTemp(Totals);
+#endif
+    }
+
+private:
+#if UNLOG_ENABLED && UNLOG_CATEGORY_STATS
+    void Subtract(const FUnlogCategoryStats& Other)
+    {
+        NumEmitted -= Other.NumEmitted;
+        NumFiltered -= Other.NumFiltered;
+        NumFormattedBytes -= Other.NumFormattedBytes;
+        FormatCycles -= Other.FormatCycles;
+        TargetCycles -= Other.TargetCycles;
+    }
+
+    // Indexed by category id
+    static TArray<FUnlogCategoryStats> Sum()
+    {
+        TArray<FUnlogCategoryStats> Totals;
+        FUnlogThreadCounters::ForEach([&Totals](int32 Id, const FUnlogCategoryCounters& Counters)
+        {
+            if (Totals.Num() <= Id)
+            {
+                Totals.SetNum(Id + 1);
+            }
+
+            FUnlogCategoryStats& Stats = Totals[Id];
+            Stats.NumEmitted += Counters.NumEmitted.load(std::memory_order_relaxed);
+            Stats.NumFiltered += Counters.NumFiltered.load(std::memory_order_relaxed);
+            Stats.NumFormattedBytes += Counters.NumFormattedBytes.load(std::memory_order_relaxed);
+            Stats.FormatCycles += Counters.FormatCycles.load(std::memory_order_relaxed);
+            Stats.TargetCycles += Counters.TargetCycles.load(std::memory_order_relaxed);
+        });
+        return Totals;
+    }
+
+    static FCriticalSection& GetBaselineLock()
+    {
+        static FCriticalSection Lock;
+        return Lock;
+    }
+
+    static TArray<FUnlogCategoryStats>& GetBaseline()
+    {
+        static TArray<FUnlogCategoryStats> Baseline;
+        return Baseline;
+    }
+#endif
+};
+
+#if UNLOG_ENABLED && UNLOG_CATEGORY_STATS
+// Console commands dumping and resetting the category stats
+class FUnlogCategoryStatsCommands
+{
+public:
+    FUnlogCategoryStatsCommands()
+        : StatsCommand(TEXT("Unlog.Categories.Stats"), TEXT("Lists how much each category logged and the time it took since the last reset, the most expensive first"),
+            FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FUnlogCategoryStatsCommands::Stats))
+        , ResetCommand(TEXT("Unlog.Categories.ResetStats"), TEXT("Starts counting the category stats from zero"),
+            FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FUnlogCategoryStatsCommands::Reset))
+    {}
+
+private:
+    static void Stats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        const double MillisecondsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000.0;
+
+        Ar.Logf(TEXT("%-32s %12s %12s %12s %12s %12s"), TEXT("Category"), TEXT("Emitted"), TEXT("Filtered"), TEXT("KB"), TEXT("Format ms"), TEXT("Targets ms"));
+        for (const FUnlogCategoryStats& Stats : FUnlogCategoryStats::Collect())
+        {
+            Ar.Logf(TEXT("%-32s %12llu %12llu %12.1f %12.3f %12.3f"),
+                *Stats.Category.ToString(),
+                (unsigned long long)Stats.NumEmitted,
+                (unsigned long long)Stats.NumFiltered,
+                Stats.NumFormattedBytes / 1024.0,
+                Stats.FormatCycles * MillisecondsPerCycle,
+                Stats.TargetCycles * MillisecondsPerCycle);
+        }
+    }
+
+    static void Reset(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        FUnlogCategoryStats::Reset();
+    }
+
+    FAutoConsoleCommand StatsCommand;
+    FAutoConsoleCommand ResetCommand;
+};
+#endif // UNLOG_ENABLED && UNLOG_CATEGORY_STATS
+
+// ------------------------------------------------------------------------------------
+// Unlog runtime
+// ------------------------------------------------------------------------------------
+#if UNLOG_ENABLED
+
+// Maximum number of scoped categories a single thread can have pushed at once
+#ifndef UNLOG_SCOPED_CATEGORY_CAPACITY
+#define UNLOG_SCOPED_CATEGORY_CAPACITY 32
+#endif
+
+/**
+* Pushed categories temporarily override the default category, usually during a certain scope.
+* Each thread has its own stack so scopes running concurrently on other threads don't interfere,
+* and being fixed size it's constant initialized, meaning no allocations nor lazy construction.
+*/
+struct FUnlogCategoryStack
+{
+    UnlogCategoryBase* Categories[UNLOG_SCOPED_CATEGORY_CAPACITY] = {};
+    int32 Num = 0;
+
+    static FUnlogCategoryStack& Get()
+    {
+        static thread_local FUnlogCategoryStack Stack;
+        return Stack;
+    }
+
+    FORCEINLINE void Push(UnlogCategoryBase& Category)
+    {
+        checkf(Num < UNLOG_SCOPED_CATEGORY_CAPACITY, TEXT("Too many scoped categories, increase UNLOG_SCOPED_CATEGORY_CAPACITY"));
+
+        // Scopes past the capacity are still counted to keep pops balanced but don't override the category
+        if (Num < UNLOG_SCOPED_CATEGORY_CAPACITY)
+        {
+            Categories[Num] = &Category;
+        }
+        ++Num;
+    }
+
+    FORCEINLINE void Pop()
+    {
+        check(Num > 0);
+        --Num;
+    }
+
+    FORCEINLINE UnlogCategoryBase* Top() const
+    {
+        return Num > 0 ? Categories[FMath::Min(Num, UNLOG_SCOPED_CATEGORY_CAPACITY) - 1] : nullptr;
+    }
+};
+
+class Unlogger
+{
+private:
+    // Settings should never be destroyed since they are statically created
+    UnlogRuntimeSettingsBase* Settings;
+
+public:
+
+    static Unlogger& Get()
+    {
+        static Unlogger Logger = CreateLogger();
+        return Logger;
+    }
+
+    static Unlogger CreateLogger()
+    {
+        // Start with default settings
+        Unlogger Logger;
+        Logger.ApplyRuntimeSettingsInternal<UnlogDefaultRuntimeSettings>();
+
+#if WITH_EDITOR
+        static const FTelemetryDispatcher TelemetryDispatcher = FTelemetryDispatcher();
+#endif
+        static const FUnlogCallSiteCommands CallSiteCommands;
+#if UNLOG_CATEGORY_STATS
+        static const FUnlogCategoryStatsCommands CategoryStatsCommands;
+#endif
+        return Logger;
+    }
+
+    template< typename TSettings >
+    static void ApplyRuntimeSettings()
+    {
+        Unlogger::Get().ApplyRuntimeSettingsInternal<TSettings>();
+    }
+
+    template< typename TSettings >
+    void ApplyRuntimeSettingsInternal()
+    {
+        Settings = &TSettings::Static();
+    }
+
+    // Pushes a category on the calling thread only
+    void PushCategory(UnlogCategoryBase& Category)
+    {
+        FUnlogCategoryStack::Get().Push(Category);
+    }
+
+    void PopCategory()
+    {
+        FUnlogCategoryStack::Get().Pop();
+    }
+
+    template<typename CategoryPicker>
+    FORCEINLINE const UnlogCategoryBase& PickCategory()
+    {
+        UnlogCategoryBase* SelectedCategory = FUnlogCategoryStack::Get().Top();
+
+        CategoryPicker::PickCategory(SelectedCategory);
+
+        check(SelectedCategory);
+        return *SelectedCategory;
+    }
+
+    // Use ordered arguments format
+    template<
+        typename FormatOptions,
+        typename FMT,
+        typename... ArgTypes >
+    FORCEINLINE typename TEnableIf<!FormatOptions::IsPrintfFormat>::Type ProcessFormatString(FStringBuilderBase& Out, const FMT& Format, const FUnlogMessageArgs& MessageArgs, const ArgTypes&... Args)
+    {
+        UnlogFormat::Render(Out, Format, MessageArgs.Args, MessageArgs.NumArgs);
+    }
+
+    // Use Printf format
+    template<
+        typename FormatOptions,
+        typename FMT,
+        typename... ArgTypes >
+    FORCEINLINE typename TEnableIf<FormatOptions::IsPrintfFormat>::Type ProcessFormatString(FStringBuilderBase& Out, const FMT& Format, const FUnlogMessageArgs& MessageArgs, const ArgTypes&... Args)
+    {
+        static_assert(!TIsArrayOrRefOfType<FMT, char>::Value, "Unlog's printf style functions only support text wrapped by TEXT()");
+        Out.Appendf(Format, Args...);
+    }
+
+    template<typename StaticConfiguration, typename FMT, typename... ArgTypes>
+    void UnlogPrivateImpl(const FMT& Format, ELogVerbosity::Type Verbosity, ArgTypes&&... Args)
+    {
+        const auto& Category = PickCategory< typename StaticConfiguration::CategoryPicker>();
+
+        // Single relaxed load, rejected messages never reach the call site registry, the formatting nor the targets
+        if (Verbosity <= Category.GetVerbosity() && Verbosity != ELogVerbosity::NoLogging)
+        {
+            // Registering replays the switches, so a call site can turn out to be off on its first hit
+            const ANSICHAR* Function = nullptr;
+            FUnlogCallSite* CallSite = UnlogFormat::GetCallSite(Format, Function);
+            if (CallSite && !CallSite->IsRegistered())
+            {
+                CallSite->Register(Function, UnlogFormat::GetFormatKey(UnlogFormat::GetFormat(Format)), UnlogFormat::GetText(UnlogFormat::GetFormat(Format)), Category);
+                if (!CallSite->IsEnabled())
+                {
+                    return;
+                }
+            }
+
+            FUnlogMessageSource Source;
+            Source.FormatKey = UnlogFormat::GetFormatKey(UnlogFormat::GetFormat(Format));
+            Source.CallSite = CallSite;
+
+#if UNLOG_CATEGORY_STATS
+            FUnlogCategoryCounters& Counters = FUnlogThreadCounters::Find(Category);
+#endif
+
+            if (!StaticConfiguration::FilterOptions::template ShouldLog<typename StaticConfiguration::TargetOptions>(Source, Category, Verbosity))
+            {
+#if UNLOG_CATEGORY_STATS
+                FUnlogCategoryCounters::Add(Counters.NumFiltered, 1);
+#endif
+                return;
+            }
+
+            using FormatOptions = typename StaticConfiguration::FormatOptions;
+            const TUnlogFormatArgs<FormatOptions::IsPrintfFormat, sizeof...(ArgTypes)> FormatArgs{ Args... };
+            FUnlogMessageArgs MessageArgs = FormatArgs.MakeMessageArgs(UnlogFormat::GetFormat(Format));
+
+#if UNLOG_CATEGORY_STATS
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+#endif
+
+            // Formatting into an inline buffer means most messages never touch the heap.
+            // Skipped altogether when the targets only need the arguments
+            TStringBuilder<UNLOG_INLINE_BUFFER_SIZE> Result;
+            if (FormatOptions::IsPrintfFormat || Target::TNeedsMessage<typename StaticConfiguration::TargetOptions>::Value)
+            {
+                ProcessFormatString<FormatOptions>(Result, UnlogFormat::GetFormat(Format), MessageArgs, Args...);
+
+                // Printf formats have no fields
+                const int32 FieldsStart = Result.Len();
+                UnlogFormat::AppendFields(Result, MessageArgs.Args, MessageArgs.NumArgs);
+                MessageArgs.SetMessage(FStringView(Result.ToString(), Result.Len()), FieldsStart);
+            }
+
+#if UNLOG_CATEGORY_STATS
+            const uint64 FormattedCycles = FPlatformTime::Cycles64();
+#endif
+
+            // Execute all static targets
+            Target::CallTarget<typename StaticConfiguration::TargetOptions>(Source, Category, Verbosity, MessageArgs);
+
+#if UNLOG_CATEGORY_STATS
+            const uint64 EndCycles = FPlatformTime::Cycles64();
+            FUnlogCategoryCounters::Add(Counters.NumEmitted, 1);
+            FUnlogCategoryCounters::Add(Counters.NumFormattedBytes, Result.Len() * sizeof(TCHAR));
+            FUnlogCategoryCounters::Add(Counters.FormatCycles, FormattedCycles - StartCycles);
+            FUnlogCategoryCounters::Add(Counters.TargetCycles, EndCycles - FormattedCycles);
+#endif
+        }
+#if UNLOG_CATEGORY_STATS && UNLOG_CATEGORY_STATS_VERBOSITY
+        else
+        {
+            FUnlogCategoryCounters::Add(FUnlogThreadCounters::Find(Category).NumFiltered, 1);
+        }
+#endif
+    }
+};
+
+// Routes a logging call to Unlogger, or to nothing when its verbosity is compiled out of the logger
+template< bool IsCompiledIn >
+struct TUnlogDispatch
+{
+    template<typename StaticConfiguration, typename FMT, typename... ArgTypes>
+    FORCEINLINE static void Run(const FMT& Format, ELogVerbosity::Type Verbosity, ArgTypes&&... Args)
+    {
+        if (UnlogFormat::IsCallSiteEnabled(Format))
+        {
+            Unlogger::Get().UnlogPrivateImpl<StaticConfiguration>(Format, Verbosity, Forward<ArgTypes>(Args)...);
+        }
+    }
+};
+
+template<>
+struct TUnlogDispatch<false>
+{
+    template<typename StaticConfiguration, typename FMT, typename... ArgTypes>
+    FORCEINLINE static void Run(const FMT& Format, ELogVerbosity::Type Verbosity, ArgTypes&&... Args)
+    {}
+};
+#endif // UNLOG_ENABLED
+
+#if UNLOG_ENABLED
+template< typename TCategory >
+struct FUnlogScopedCategory
+{
+    FUnlogScopedCategory()
+    {
+        Unlogger::Get().PushCategory(TCategory::Static());
+    }
+
+    ~FUnlogScopedCategory()
+    {
+        Unlogger::Get().PopCategory();
+    }
+};
+#endif
+
+// ------------------------------------------------------------------------------------
+// Contexts (Experimental)
+// 
+// Tracks when the program has entered a specific "context", able to be queried 
+// by another system later down the callstack to selectively exclude certain log calls
+// without creating a direct dependency between systems to query state.
+// 
+// e.g. Ignore logging a widget when part of the editor callstack
+// 
+// Could technically be repurposed to selectively run other code besides logging.
+// ------------------------------------------------------------------------------------
+template <typename ActualType>
+class UnlogContextBase
+{
+public:
+
+    UnlogContextBase(const FName& InName)
+        : ContextName(InName)
+        , Counter(0u)
+    {}
+
+    FORCEINLINE static ActualType& Static()
+    {
+        static ActualType Type = ActualType::Construct();
+        return Type;
+    }
+
+    FORCEINLINE const FName& GetName() const
+    {
+        return ContextName;
+    }
+
+    FORCEINLINE void IncrementCounter()
+    {
+        Counter++;
+    }
+
+    FORCEINLINE void DecrementCounter()
+    {
+        check(Counter > 0u);
+        Counter--;
+    }
+
+    FORCEINLINE bool IsActive() const
+    {
+        return Counter > 0u;
+    }
+
+    template< typename Functor >
+    FORCEINLINE static void WhenActive(Functor Func)
+    {
+        if (ActualType::Static().IsActive())
+        {
+            Func();
+        }
+    }
+
+    template< typename Functor >
+    FORCEINLINE static void WhenNotActive(Functor Func)
+    {
+        if (!ActualType::Static().IsActive())
+        {
+            Func();
+        }
+    }
+
+private:
+    FName ContextName;
+    uint32 Counter;
+};
+
+#define UNLOG_CONTEXT(ContextName) \
+class ContextName : public UnlogContextBase< ContextName > \
+{\
+public:\
+    using UnlogContextBase< ContextName >::UnlogContextBase; \
+    static ContextName Construct()\
+    {\
+        return ContextName( TEXT( #ContextName ) );\
+    }\
+};
+
+template <typename TContext >
+struct UnloggerScopedContextEntered
+{
+    UnloggerScopedContextEntered(bool InValue)
+        : Value(InValue)
+    {
+        if (Value)
+        {
+            TContext::Static().IncrementCounter();
+        }
+    }
+
+    UnloggerScopedContextEntered()
+        : UnloggerScopedContextEntered(true)
+    {}
+
+    ~UnloggerScopedContextEntered()
+    {
+        if (Value)
+        {
+            TContext::Static().DecrementCounter();
+        }
+    }
+private:
+    bool Value;
+};
+
+#define UNLOG_CONTEXT_ENTERED(ContextName, ...) \
+    UnloggerScopedContextEntered< ContextName > ScopedContext_##ContextName( __VA_ARGS__ )
+
+
+// ------------------------------------------------------------------------------------
+// Flushing
+// ------------------------------------------------------------------------------------
+
+/**
+* Binding to the engine delegates isn't thread safe, while Unlog's stages are created by whichever
+* thread first logs through them. Runs Functor right away on the game thread, otherwise queues it there.
+*/
+struct FUnlogGameThread
+{
+    template< typename FunctorType >
+    static void Run(FunctorType&& Functor)
+    {
+        if (IsInGameThread())
+        {
+            Functor();
+        }
+        else
+        {
+            AsyncTask(ENamedThreads::GameThread, Forward<FunctorType>(Functor));
+        }
+    }
+};
+
+/**
+* Anything holding on to messages before handing them to their final destination (e.g async queues
+* or batching targets) registers itself here so Unlog::Flush can push everything out at once.
+*/
+class FUnlogFlushable
+{
+public:
+    virtual ~FUnlogFlushable() = default;
+
+    /**
+    * Blocks until every message held so far has been handed over. Returns whether any message was
+    * handed over since the previous flush, including by other threads (e.g an async queue's worker).
+    */
+    virtual bool Flush() = 0;
+
+    static void FlushAll()
+    {
+        // Flushing one can hand messages to another (e.g an async queue feeding a batching target) in any
+        // registration order, so passes repeat until none of them moved anything. Bounded in case other
+        // threads keep logging meanwhile
+        constexpr int32 MaxPasses = 8;
+        for (int32 Pass = 0; Pass < MaxPasses; ++Pass)
+        {
+            // Flushed outside the lock in case a target flushes from one of the worker threads.
+            // Copied on every pass to pick up the ones created while flushing
+            TArray<FUnlogFlushable*> Flushables;
+            {
+                FScopeLock Lock(&GetRegistryLock());
+                Flushables = GetRegistry();
+            }
+
+            bool bHandedOver = false;
+            for (FUnlogFlushable* Flushable : Flushables)
+            {
+                bHandedOver |= Flushable->Flush();
+            }
+
+            if (!bHandedOver)
+            {
+                break;
+            }
+        }
+    }
+
+protected:
+    static void Register(FUnlogFlushable* Flushable)
+    {
+        FScopeLock Lock(&GetRegistryLock());
+        GetRegistry().Add(Flushable);
+    }
+
+    static void Unregister(FUnlogFlushable* Flushable)
+    {
+        FScopeLock Lock(&GetRegistryLock());
+        GetRegistry().Remove(Flushable);
+    }
+
+private:
+    static FCriticalSection& GetRegistryLock()
+    {
+        static FCriticalSection RegistryLock;
+        return RegistryLock;
+    }
+
+    static TArray<FUnlogFlushable*>& GetRegistry()
+    {
+        static TArray<FUnlogFlushable*> Registry;
+        return Registry;
+    }
+};
+
+// ------------------------------------------------------------------------------------
+// Targets
+// 
+// Specifies where log messages should be routed to.
+// 
+// By default all messages are routed to FMsg::Log so it's as similar as executing 
+// UE_LOG. There's also a few other options like the Viewport or the MessageLog.
+// 
+// Multiple targets can be used by chaining them inside a TMultiTarget
+// 
+// Messages are passed as a view into the formatting buffer. The view is always null
+// terminated but it's only valid for the duration of the call, targets needing to
+// hold on to the message should copy it.
+// 
+// Targets can also receive where the message comes from, see FUnlogMessageSource.
+// ------------------------------------------------------------------------------------
+// Lines whose repeats Target::TKeyedViewport keeps counting, the ones that left the screen make room first
+#ifndef UNLOG_KEYED_VIEWPORT_MAX_KEYS
+#define UNLOG_KEYED_VIEWPORT_MAX_KEYS 256
+#endif
+
+namespace Target
+{
+    /**
+    * Combines multiple targets together.
+    * e.g: TMultiTarget< Target::UELog, Target::Viewport>
+    */
+    template< typename... TTargets >
+    struct TMultiTarget
+    {
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            auto Ignore = { (CallTarget<TTargets>(Source, Category, Verbosity, Message),0)... };
+            (void)Ignore;
+        }
+
+        static void Call(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            Call(FUnlogMessageSource(), Category, Verbosity, Message);
+        }
+
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FUnlogMessageArgs& Args)
+        {
+            auto Ignore = { (CallTarget<TTargets>(Source, Category, Verbosity, Args),0)... };
+            (void)Ignore;
+        }
+    };
+
+    // Messages are formatted as soon as one of the combined targets needs them
+    template< typename... TTargets >
+    struct TNeedsMessage< TMultiTarget<TTargets...> >
+    {
+        static constexpr bool Value = TOr<TNeedsMessage<TTargets>...>::Value;
+    };
+
+    /**
+    * Default logging target option just like UE_LOG.
+    * The message is already formatted so it's handed straight to the output devices, following the
+    * same routing as FMsg::Logf without formatting it a second time.
+    */
+    struct UELog
+    {
+        static void Call(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            // Fatal messages still go through FMsg so the engine takes care of crashing
+            if (Verbosity == ELogVerbosity::Fatal)
+            {
+                FMsg::Logf(nullptr, 0, Category.GetName(), Verbosity, TEXT("%.*s"), Message.Len(), Message.GetData());
+                return;
+            }
+
+            const bool bIsWarnVerbosity = Verbosity == ELogVerbosity::Error || Verbosity == ELogVerbosity::Warning || Verbosity == ELogVerbosity::Display;
+            FOutputDevice* LogDevice = bIsWarnVerbosity && GWarn ? static_cast<FOutputDevice*>(GWarn) : static_cast<FOutputDevice*>(GLog);
+
+            // Views handed to targets are null terminated
+            LogDevice->Serialize(Message.GetData(), Verbosity, Category.GetName());
+        }
+    };
+
+    /**
+    * Output messages to the in-game viewport.
+    * Both TimeOnScreen and Color are statically configurable
+    */
+    template< int TimeOnScreen, const FColor& InColor >
+    struct TViewport
+    {
+        static void Call(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            GEngine->AddOnScreenDebugMessage(INDEX_NONE, TimeOnScreen, InColor, FString(Message.Len(), Message.GetData()));
+        }
+    };
+
+    // Default viewport configuration - outputs the message on-screen for 3 seconds and colored in Cyan
+    using Viewport = TViewport<3, FColor::Cyan>;
+
+    /**
+    * Output messages to the in-game viewport reusing the same line for every message coming from
+    * the same call site (or identical messages if the call site is unknown) along with a repeat count.
+    * Logging every frame (e.g inside Tick) keeps updating a single line instead of adding new ones.
+    */
+    template< int TimeOnScreen, const FColor& InColor >
+    struct TKeyedViewport
+    {
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            const uint64 Key = MakeKey(Source, Category, Message);
+
+            TStringBuilder<UNLOG_INLINE_BUFFER_SIZE> Line;
+            Line.Append(Message.GetData(), Message.Len());
+
+            const uint32 Count = CountRepeats(Key);
+            if (Count > 1)
+            {
+                Line.Appendf(TEXT(" (x%u)"), Count);
+            }
+
+            GEngine->AddOnScreenDebugMessage(Key, TimeOnScreen, InColor, FString(Line.Len(), Line.ToString()));
+        }
+
+        static void Call(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            Call(FUnlogMessageSource(), Category, Verbosity, Message);
+        }
+
+    private:
+        static uint64 MakeKey(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, FStringView Message)
+        {
+            const uint64 MessageKey = Source.FormatKey
+                ? (uint64)(UPTRINT)Source.FormatKey
+                : (uint64)FCrc::MemCrc32(Message.GetData(), Message.Len() * sizeof(TCHAR));
+
+            const uint64 Key = MessageKey ^ ((uint64)PointerHash(&Category) << 32);
+
+            // INDEX_NONE would add a new line every time
+            return Key != (uint64)INDEX_NONE ? Key : 0;
+        }
+
+        // Repeats only count while the previous message is still on screen
+        static uint32 CountRepeats(uint64 Key)
+        {
+            // Messages without a call site are keyed by their text, which can be different every time
+            constexpr int32 MaxKeys = UNLOG_KEYED_VIEWPORT_MAX_KEYS;
+
+            struct FRepeats
+            {
+                uint32 Count = 0;
+                double LastTime = 0.0;
+            };
+
+            static FCriticalSection RepeatsLock;
+            static TMap<uint64, FRepeats> RepeatsByKey;
+
+            const double Now = FPlatformTime::Seconds();
+
+            FScopeLock Lock(&RepeatsLock);
+            if (RepeatsByKey.Num() >= MaxKeys && !RepeatsByKey.Contains(Key))
+            {
+                // Lines that left the screen don't need their count anymore
+                TArray<uint64> Expired;
+                for (const auto& Pair : RepeatsByKey)
+                {
+                    if (Now - Pair.Value.LastTime > TimeOnScreen)
+                    {
+                        Expired.Add(Pair.Key);
+                    }
+                }
+
+                for (const uint64 ExpiredKey : Expired)
+                {
+                    RepeatsByKey.Remove(ExpiredKey);
+                }
+
+                // Still mostly full, more lines than anyone can read so counting starts over. Keeps sweeps
+                // from running on every new key
+                if (RepeatsByKey.Num() >= MaxKeys / 2)
+                {
+                    RepeatsByKey.Reset();
+                }
+            }
+
+            FRepeats& Repeats = RepeatsByKey.FindOrAdd(Key);
+            Repeats.Count = Now - Repeats.LastTime <= TimeOnScreen ? Repeats.Count + 1 : 1;
+            Repeats.LastTime = Now;
+            return Repeats.Count;
+        }
+    };
+
+    // Default keyed viewport configuration - same as Viewport but one line per call site
+    using KeyedViewport = TKeyedViewport<3, FColor::Cyan>;
+
+    using Default = UELog;
+}
+
+// ------------------------------------------------------------------------------------
+// Async logging
+// 
+// Optional backend that moves the targets off the logging thread. Messages are still
+// formatted by the caller, then copied into a bounded lock-free queue that a dedicated
+// worker thread drains by running the wrapped targets.
+// 
+// Enabled per logger using the builder pattern:
+// using MyLogger = TUnlog<>::WithTargets< Target::UELog, Target::Viewport >::WithAsync<>;
+// ------------------------------------------------------------------------------------
+
+// Number of messages an async logger can hold before applying its EUnlogAsyncPolicy
+#ifndef UNLOG_ASYNC_QUEUE_CAPACITY
+#define UNLOG_ASYNC_QUEUE_CAPACITY 1024
+#endif
+
+// Characters of a queued message stored inline, only longer messages allocate
+#ifndef UNLOG_ASYNC_INLINE_MESSAGE_SIZE
+#define UNLOG_ASYNC_INLINE_MESSAGE_SIZE 256
+#endif
+
+// What an async logger does when its queue is full
+enum class EUnlogAsyncPolicy : uint8
+{
+    // Wait for the worker thread to make room, no message is lost
+    Block,
+    // Discard the new message
+    Drop,
+    // Discard the oldest queued message to make room for the new one
+    OverwriteOldest
+};
+
+#if UNLOG_ENABLED
+/**
+* Bounded queue based on Dmitry Vyukov's algorithm.
+* Every cell carries a sequence number telling whether it's ready to be written or read,
+* so claiming a cell is a single compare-and-swap and no locks are ever taken.
+* Elements are written and read in place through functors to avoid copying them around.
+*/
+template< typename ElementType, int32 Capacity >
+class TUnlogBoundedQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Unlog queue capacity must be a power of two");
+
+    struct FCell
+    {
+        std::atomic<uint64> Sequence;
+        ElementType Element;
+    };
+
+public:
+    TUnlogBoundedQueue()
+        : Cells(new FCell[Capacity])
+        , EnqueuePos(0)
+        , DequeuePos(0)
+    {
+        for (int32 Index = 0; Index < Capacity; ++Index)
+        {
+            Cells[Index].Sequence.store(Index, std::memory_order_relaxed);
+        }
+    }
+
+    ~TUnlogBoundedQueue()
+    {
+        delete[] Cells;
+    }
+
+    TUnlogBoundedQueue(const TUnlogBoundedQueue&) = delete;
+    TUnlogBoundedQueue& operator=(const TUnlogBoundedQueue&) = delete;
+
+    // Claims a free cell and fills it using Writer(ElementType&), fails if the queue is full
+    template< typename WriterType >
+    bool TryEnqueue(WriterType&& Writer)
+    {
+        uint64 Pos = EnqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            FCell& Cell = Cells[Pos & (Capacity - 1)];
+            const int64 Difference = (int64)Cell.Sequence.load(std::memory_order_acquire) - (int64)Pos;
+
+            if (Difference == 0)
+            {
+                if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+                {
+                    Writer(Cell.Element);
+                    Cell.Sequence.store(Pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (Difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                Pos = EnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Claims the oldest element and hands it to Reader(ElementType&), fails if the queue is empty
+    template< typename ReaderType >
+    bool TryDequeue(ReaderType&& Reader)
+    {
+        uint64 Pos = DequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            FCell& Cell = Cells[Pos & (Capacity - 1)];
+            const int64 Difference = (int64)Cell.Sequence.load(std::memory_order_acquire) - (int64)(Pos + 1);
+
+            if (Difference == 0)
+            {
+                if (DequeuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+                {
+                    Reader(Cell.Element);
+                    Cell.Sequence.store(Pos + Capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (Difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                Pos = DequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Approximate when other threads are using the queue
+    bool IsEmpty() const
+    {
+        return DequeuePos.load(std::memory_order_seq_cst) >= EnqueuePos.load(std::memory_order_seq_cst);
+    }
+
+private:
+    FCell* Cells;
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePos;
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> DequeuePos;
+};
+
+// Copy of a formatted message waiting in an async queue
+struct FUnlogAsyncRecord
+{
+    FUnlogMessageSource Source;
+    const UnlogCategoryBase* Category = nullptr;
+    ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+    int32 Length = 0;
+    TCHAR InlineMessage[UNLOG_ASYNC_INLINE_MESSAGE_SIZE];
+    FString LongMessage;
+
+    void Write(const FUnlogMessageSource& InSource, const UnlogCategoryBase& InCategory, ELogVerbosity::Type InVerbosity, FStringView Message)
+    {
+        Source = InSource;
+        Category = &InCategory;
+        Verbosity = InVerbosity;
+        Length = Message.Len();
+
+        if (Length < UNLOG_ASYNC_INLINE_MESSAGE_SIZE)
+        {
+            FMemory::Memcpy(InlineMessage, Message.GetData(), Length * sizeof(TCHAR));
+            InlineMessage[Length] = TEXT('\0');
+        }
+        else
+        {
+            LongMessage = FString(Length, Message.GetData());
+        }
+    }
+
+    // Null terminated just like the views targets receive from the logging thread
+    FStringView GetMessage() const
+    {
+        return FStringView(Length < UNLOG_ASYNC_INLINE_MESSAGE_SIZE ? InlineMessage : *LongMessage, Length);
+    }
+};
+
+/**
+* Queue and worker thread shared by every async logger with the same targets and settings.
+* Lazily started on the first message, flushed and stopped when the engine exits.
+* Messages logged after shutdown, or from inside one of the wrapped targets, run synchronously.
+*/
+template< typename InTargetOptions, EUnlogAsyncPolicy Policy, int32 QueueCapacity >
+class TUnlogAsyncBackend : public FUnlogFlushable, public FRunnable
+{
+public:
+    static TUnlogAsyncBackend& Get()
+    {
+        static TUnlogAsyncBackend Backend;
+        return Backend;
+    }
+
+    void Push(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+    {
+        if (!bRunning.load(std::memory_order_acquire) || IsWorkerThread())
+        {
+            Target::CallTarget<InTargetOptions>(Source, Category, Verbosity, Message);
+            return;
+        }
+
+        const auto Writer = [&](FUnlogAsyncRecord& Record)
+        {
+            Record.Write(Source, Category, Verbosity, Message);
+        };
+
+        if (!Queue.TryEnqueue(Writer))
+        {
+            switch (Policy)
+            {
+            case EUnlogAsyncPolicy::Block:
+                do
+                {
+                    if (!bRunning.load(std::memory_order_acquire))
+                    {
+                        Target::CallTarget<InTargetOptions>(Source, Category, Verbosity, Message);
+                        return;
+                    }
+
+                    WakeWorker();
+                    FPlatformProcess::Yield();
+                } 
+                while (!Queue.TryEnqueue(Writer));
+                break;
+
+            case EUnlogAsyncPolicy::Drop:
+                NumDropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+
+            case EUnlogAsyncPolicy::OverwriteOldest:
+                do
+                {
+                    if (Queue.TryDequeue([](FUnlogAsyncRecord&) {}))
+                    {
+                        NumDropped.fetch_add(1, std::memory_order_relaxed);
+                    }
+                } 
+                while (!Queue.TryEnqueue(Writer));
+                break;
+            }
+        }
+
+        WakeWorker();
+    }
+
+    // Messages discarded because the queue was full, either new ones or overwritten ones depending on the policy
+    uint64 GetNumDropped() const
+    {
+        return NumDropped.load(std::memory_order_relaxed);
+    }
+
+    virtual bool Flush() override
+    {
+        // The worker is already draining, waiting on itself would deadlock
+        if (IsWorkerThread())
+        {
+            return false;
+        }
+
+        FScopeLock Lock(&ConsumerLock);
+        ProcessQueue();
+
+        // Also counts what the worker handed over since the previous flush
+        const bool bHandedOver = NumProcessed != NumProcessedAtFlush;
+        NumProcessedAtFlush = NumProcessed;
+        return bHandedOver;
+    }
+
+    // Flushes and stops the worker thread, any later message will run synchronously
+    void Shutdown()
+    {
+        if (bRunning.exchange(false))
+        {
+            WorkEvent->Trigger();
+            Thread->WaitForCompletion();
+            delete Thread;
+            Thread = nullptr;
+        }
+
+        FScopeLock Lock(&ConsumerLock);
+        ProcessQueue();
+    }
+
+    // FRunnable interface
+    virtual uint32 Run() override
+    {
+        WorkerThreadId.store(FPlatformTLS::GetCurrentThreadId(), std::memory_order_relaxed);
+
+        while (bRunning.load(std::memory_order_acquire))
+        {
+            {
+                FScopeLock Lock(&ConsumerLock);
+                ProcessQueue();
+            }
+
+            bWorkerIdle.store(true);
+
+            // Pairs with WakeWorker, a message pushed right before going idle is never left waiting
+            if (Queue.IsEmpty() && bRunning.load(std::memory_order_acquire))
+            {
+                WorkEvent->Wait(WorkerIdleTimeoutMs);
+            }
+
+            bWorkerIdle.store(false);
+        }
+        return 0;
+    }
+
+private:
+    // Upper bound on how long the worker sleeps, only matters if a wake up is ever missed
+    static constexpr uint32 WorkerIdleTimeoutMs = 100;
+
+    TUnlogAsyncBackend()
+        : bRunning(false)
+        , bWorkerIdle(false)
+        , WorkerThreadId(0)
+        , NumDropped(0)
+        , NumReportedDropped(0)
+        , NumProcessed(0)
+        , NumProcessedAtFlush(0)
+        , WorkEvent(FPlatformProcess::GetSynchEventFromPool())
+        , Thread(nullptr)
+    {
+        Register(this);
+        FUnlogGameThread::Run([this]
+        {
+            ExitHandle = FCoreDelegates::OnExit.AddRaw(this, &TUnlogAsyncBackend::Shutdown);
+            SystemErrorHandle = FCoreDelegates::OnHandleSystemError.AddRaw(this, &TUnlogAsyncBackend::FlushOnError);
+            ShutdownAfterErrorHandle = FCoreDelegates::OnShutdownAfterError.AddRaw(this, &TUnlogAsyncBackend::FlushOnError);
+        });
+
+        if (FPlatformProcess::SupportsMultithreading())
+        {
+            bRunning = true;
+            Thread = FRunnableThread::Create(this, TEXT("UnlogAsync"), 0, TPri_BelowNormal);
+            bRunning = Thread != nullptr;
+        }
+    }
+
+    virtual ~TUnlogAsyncBackend()
+    {
+        Shutdown();
+
+        FCoreDelegates::OnExit.Remove(ExitHandle);
+        FCoreDelegates::OnHandleSystemError.Remove(SystemErrorHandle);
+        FCoreDelegates::OnShutdownAfterError.Remove(ShutdownAfterErrorHandle);
+        Unregister(this);
+
+        FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+    }
+
+    bool IsWorkerThread() const
+    {
+        return WorkerThreadId.load(std::memory_order_relaxed) == FPlatformTLS::GetCurrentThreadId();
+    }
+
+    void WakeWorker()
+    {
+        if (bWorkerIdle.exchange(false))
+        {
+            WorkEvent->Trigger();
+        }
+    }
+
+    // Must be called with ConsumerLock held
+    void ProcessQueue()
+    {
+        ReportDropped();
+        NumProcessed += DrainQueue();
+    }
+
+    // Runs the targets on every queued message, returning how many there were. Only touches the queue,
+    // which is safe to drain from multiple threads at once
+    uint64 DrainQueue()
+    {
+        uint64 NumDrained = 0;
+        while (Queue.TryDequeue([](FUnlogAsyncRecord& Record) { Target::CallTarget<InTargetOptions>(Record.Source, *Record.Category, Record.Verbosity, Record.GetMessage()); }))
+        {
+            ++NumDrained;
+        }
+        return NumDrained;
+    }
+
+    void ReportDropped()
+    {
+        const uint64 Dropped = NumDropped.load(std::memory_order_relaxed);
+        if (Dropped != NumReportedDropped)
+        {
+            TStringBuilder<128> Message;
+            Message.Appendf(TEXT("Unlog async queue was full, %llu messages were dropped"), (unsigned long long)(Dropped - NumReportedDropped));
+            Target::CallTarget<InTargetOptions>(FUnlogMessageSource(), LogGeneral::Static(), ELogVerbosity::Warning, FStringView(Message.ToString(), Message.Len()));
+            NumReportedDropped = Dropped;
+        }
+    }
+
+    // The worker might be the thread that crashed while holding the lock, so don't wait for it.
+    // Without the lock only the queue is drained, leaving what the lock guards to its owner
+    void FlushOnError()
+    {
+        if (ConsumerLock.TryLock())
+        {
+            ProcessQueue();
+            ConsumerLock.Unlock();
+        }
+        else
+        {
+            DrainQueue();
+        }
+    }
+
+    TUnlogBoundedQueue<FUnlogAsyncRecord, QueueCapacity> Queue;
+    std::atomic<bool> bRunning;
+    std::atomic<bool> bWorkerIdle;
+    std::atomic<uint32> WorkerThreadId;
+    std::atomic<uint64> NumDropped;
+    uint64 NumReportedDropped;
+    // Both guarded by ConsumerLock
+    uint64 NumProcessed;
+    uint64 NumProcessedAtFlush;
+    FCriticalSection ConsumerLock;
+    FEvent* WorkEvent;
+    FRunnableThread* Thread;
+    FDelegateHandle ExitHandle;
+    FDelegateHandle SystemErrorHandle;
+    FDelegateHandle ShutdownAfterErrorHandle;
+};
+#endif // UNLOG_ENABLED
+
+namespace Target
+{
+    /**
+    * Runs the wrapped targets on a worker thread, usually created through TUnlog::WithAsync.
+    * e.g: TAsync< Target::UELog, EUnlogAsyncPolicy::Drop, 4096 >
+    */
+    template< typename InTargetOptions, EUnlogAsyncPolicy Policy = EUnlogAsyncPolicy::Block, int32 QueueCapacity = UNLOG_ASYNC_QUEUE_CAPACITY >
+    struct TAsync
+    {
+#if UNLOG_ENABLED
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+        {
+            TUnlogAsyncBackend<InTargetOptions, Policy, QueueCapacity>::Get().Push(Source, Category, Verbosity, Message);
+        }
+
+        static uint64 GetNumDropped()
+        {
+            return TUnlogAsyncBackend<InTargetOptions, Policy, QueueCapacity>::Get().GetNumDropped();
+        }
+#else
+        static uint64 GetNumDropped()
+        {
+            return 0;
+        }
+#endif // UNLOG_ENABLED
+    };
+}
 
 // ------------------------------------------------------------------------------------
-// Targets
-// 
-// Specifies where log messages should be routed to.
-// 
-// By default all messages are routed to FMsg::Log so it's as similar as executing 
-// UE_LOG. There's also a few other options like the Viewport or the MessageLog.
+// Deduplication
 // 
-// Multiple targets can be used by chaining them inside a TMultiTarget
+// Optional stage collapsing consecutive identical messages of a category into the first
+// one plus a "repeated N times" line, emitted once a different message comes in or after
+// a timeout. Wraps any targets, just like async logging:
+// using MyLogger = TUnlog<>::WithTargets< Target::UELog, Target::Viewport >::WithDeduplication<>;
 // ------------------------------------------------------------------------------------
+
+// Seconds repeats are held for before reporting them, even if the same message keeps coming
+#ifndef UNLOG_DEDUPLICATION_TIMEOUT
+#define UNLOG_DEDUPLICATION_TIMEOUT 5
+#endif
+
+#if UNLOG_ENABLED
+template< typename InTargetOptions, int32 TimeoutSeconds >
+class TUnlogDeduplicator : public FUnlogFlushable
+{
+public:
+    static TUnlogDeduplicator& Get()
+    {
+        static TUnlogDeduplicator Deduplicator;
+        return Deduplicator;
+    }
+
+    void Push(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
+    {
+        const uint32 Hash = FCrc::MemCrc32(Message.GetData(), Message.Len() * sizeof(TCHAR));
+        const double Now = FPlatformTime::Seconds();
+
+        // Categories past the table's capacity aren't deduplicated
+        FState* StatePtr = FStateTable::Get().FindOrAdd(&Category);
+        if (StatePtr == nullptr)
+        {
+            Target::CallTarget<InTargetOptions>(Source, Category, Verbosity, Message);
+            return;
+        }
+
+        FState& State = *StatePtr;
+        FRepeated Repeated;
+        bool bIsRepeat = false;
+        {
+            FScopeLock Lock(&State.Lock);
+
+            if (State.IsSameMessage(Hash, Verbosity, Message))
+            {
+                ++State.NumRepeats;
+                State.FirstRepeatTime = State.NumRepeats == 1 ? Now : State.FirstRepeatTime;
+
+                // Keeps a never ending stream of repeats from staying silent forever
+                if (Now - State.FirstRepeatTime < TimeoutSeconds)
+                {
+                    return;
+                }
+
+                Repeated = State.TakeRepeats();
+                bIsRepeat = true;
+            }
+            else
+            {
+                Repeated = State.TakeRepeats();
+                State.Category = &Category;
+                State.Hash = Hash;
+                State.Verbosity = Verbosity;
+                State.Message = FString(Message.Len(), Message.GetData());
+            }
+        }
+
+        // Targets are run outside the lock in case they end up logging too
+        Report(Category, Repeated);
+        if (!bIsRepeat)
+        {
+            Target::CallTarget<InTargetOptions>(Source, Category, Verbosity, Message);
+        }
+    }
+
+    // Reports every pending repeat, regardless of the timeout
+    virtual bool Flush() override
+    {
+        return ReportOlderThan(0.0);
+    }
+
+private:
+    struct FRepeated
+    {
+        uint32 NumRepeats = 0;
+        ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+    };
+
+    // Each category has its own lock, so categories logging from different threads don't wait on each other
+    struct FState
+    {
+        FCriticalSection Lock;
+        const UnlogCategoryBase* Category = nullptr;
+        uint32 Hash = 0;
+        ELogVerbosity::Type Verbosity = ELogVerbosity::NoLogging;
+        FString Message;
+        uint32 NumRepeats = 0;
+        double FirstRepeatTime = 0.0;
+
+        // The hash is only a shortcut, the whole message is compared before counting it as a repeat
+        bool IsSameMessage(uint32 InHash, ELogVerbosity::Type InVerbosity, FStringView InMessage) const
+        {
+            return Hash == InHash
+                && Verbosity == InVerbosity
+                && Message.Len() == InMessage.Len()
+                && FMemory::Memcmp(*Message, InMessage.GetData(), InMessage.Len() * sizeof(TCHAR)) == 0;
+        }
+
+        FRepeated TakeRepeats()
+        {
+            FRepeated Repeated;
+            Repeated.NumRepeats = NumRepeats;
+            Repeated.Verbosity = Verbosity;
+            NumRepeats = 0;
+            return Repeated;
+        }
+    };
+
+    TUnlogDeduplicator()
+    {
+        Register(this);
+        FUnlogGameThread::Run([this]
+        {
+            EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &TUnlogDeduplicator::ReportTimedOut);
+        });
+    }
+
+    virtual ~TUnlogDeduplicator()
+    {
+        FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+        Unregister(this);
+    }
+
+    static void Report(const UnlogCategoryBase& Category, const FRepeated& Repeated)
+    {
+        if (Repeated.NumRepeats > 0)
+        {
+            TStringBuilder<64> Line;
+            Line.Appendf(TEXT("Previous message repeated %u times"), Repeated.NumRepeats);
+            Target::CallTarget<InTargetOptions>(FUnlogMessageSource(), Category, Repeated.Verbosity, FStringView(Line.ToString(), Line.Len()));
+        }
+    }
+
+    // Repeats stopped coming in, so nothing else would report them
+    void ReportTimedOut()
+    {
+        ReportOlderThan(TimeoutSeconds);
+    }
+
+    // Returns whether there were any
+    bool ReportOlderThan(double Seconds)
+    {
+        TArray< TPair< const UnlogCategoryBase*, FRepeated > > Expired;
+        const double Now = FPlatformTime::Seconds();
+
+        FStateTable::Get().ForEach([&Expired, Now, Seconds](FState& State)
+        {
+            FScopeLock Lock(&State.Lock);
+            if (State.NumRepeats > 0 && Now - State.FirstRepeatTime >= Seconds)
+            {
+                Expired.Emplace(State.Category, State.TakeRepeats());
+            }
+        });
+
+        for (const auto& Pair : Expired)
+        {
+            Report(*Pair.Key, Pair.Value);
+        }
+        return Expired.Num() > 0;
+    }
+
+    // Keyed by category instead of format, categories live for the rest of the app's execution so their address is a stable key
+    using FStateTable = TUnlogCallSiteTable<FState, TUnlogDeduplicator>;
+
+    FDelegateHandle EndFrameHandle;
+};
+#endif // UNLOG_ENABLED
+
 namespace Target
 {
     /**
-    * Combines multiple targets together.
-    * e.g: TMultiTarget< Target::UELog, Target::Viewport>
+    * Collapses consecutive repeats of a message into a single line followed by how many times it was
+    * repeated, before handing them to the wrapped targets. Usually created through TUnlog::WithDeduplication.
+    * e.g: TDeduplicate< Target::TMultiTarget< Target::UELog, Target::MessageLog > >
     */
-    template< typename... TTargets >
-    struct TMultiTarget
+    template< typename InTargetOptions, int32 TimeoutSeconds = UNLOG_DEDUPLICATION_TIMEOUT >
+    struct TDeduplicate
     {
-        static void Call(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FString& Message)
+#if UNLOG_ENABLED
+        static void Call(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, FStringView Message)
         {
-            auto Ignore = { (TTargets::Call(Category, Verbosity, Message),0)... };
+            TUnlogDeduplicator<InTargetOptions, TimeoutSeconds>::Get().Push(Source, Category, Verbosity, Message);
         }
+#endif // UNLOG_ENABLED
     };
+}
 
-    // Default logging target option just like UE_LOG
-    struct UELog
+// ------------------------------------------------------------------------------------
+// Filters
+//
+// Decide whether a call goes through after passing the verbosity checks but before its
+// message is formatted, so rejected calls only cost the filter itself.
+//
+// Filters keeping state per call site tell them apart by their format key, see
+// UnlogFormat::GetFormatKey. Calls using the same literal or macro share their state,
+// calls with a pointer format (e.g built at runtime) all share a single one. Loggers only
+// share it when their filter and targets are the same.
+// Calls past UNLOG_CALL_SITE_SLOTS call sites are let through unfiltered.
+//
+// Multiple filters can be used by chaining them inside a TMultiFilter
+// ------------------------------------------------------------------------------------
+
+#if UNLOG_ENABLED
+// Token bucket of a single call site, packed into one timestamp (generic cell rate algorithm)
+struct FUnlogRateLimitState
+{
+    // When the bucket would be full again, in cycles. Each call let through pushes it one interval further
+    std::atomic<uint64> FullAtCycles;
+    std::atomic<uint32> NumSuppressed;
+
+    // Where the first suppressed call came from, to report them when no other call gets through
+    std::atomic<const UnlogCategoryBase*> Category;
+    std::atomic<const FUnlogCallSite*> CallSite;
+    std::atomic<ELogVerbosity::Type> Verbosity;
+
+    FUnlogRateLimitState()
+        : FullAtCycles(0)
+        , NumSuppressed(0)
+        , Category(nullptr)
+        , CallSite(nullptr)
+        , Verbosity(ELogVerbosity::Log)
+    {}
+
+    // Only the first call suppressed since the last report describes where they come from
+    FORCEINLINE void Suppress(const FUnlogMessageSource& Source, const UnlogCategoryBase& InCategory, ELogVerbosity::Type InVerbosity)
     {
-        static void Call(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FString& Message)
+        if (NumSuppressed.fetch_add(1, std::memory_order_relaxed) == 0)
         {
-            FMsg::Logf(nullptr, 0, Category.GetName(), Verbosity, TEXT("%s"), *Message);
+            CallSite.store(Source.CallSite, std::memory_order_relaxed);
+            Verbosity.store(InVerbosity, std::memory_order_relaxed);
+            Category.store(&InCategory, std::memory_order_release);
+        }
+    }
+};
+
+/**
+* Reports the calls a rate limit suppressed when no other call of their call site got through to do it,
+* once a second at the end of the frame and when calling Unlog::Flush.
+*/
+template< typename TargetOptions, typename RateLimitType >
+class TUnlogRateLimitReporter : public FUnlogFlushable
+{
+public:
+    using FStateTable = TUnlogCallSiteTable<FUnlogRateLimitState, RateLimitType, TargetOptions>;
+
+    // Never destroyed, same as the table it reports on
+    static TUnlogRateLimitReporter& Get()
+    {
+        static TUnlogRateLimitReporter* Reporter = new TUnlogRateLimitReporter();
+        return *Reporter;
+    }
+
+    virtual bool Flush() override
+    {
+        bool bReported = false;
+        FStateTable::Get().ForEach([&bReported](FUnlogRateLimitState& State)
+        {
+            const uint32 NumSuppressed = State.NumSuppressed.exchange(0, std::memory_order_relaxed);
+            if (NumSuppressed == 0)
+            {
+                return;
+            }
+
+            // The very first suppressed call may not have described itself yet, leave them for the next report
+            const UnlogCategoryBase* Category = State.Category.load(std::memory_order_acquire);
+            if (!Category)
+            {
+                State.NumSuppressed.fetch_add(NumSuppressed, std::memory_order_relaxed);
+                return;
+            }
+
+            TStringBuilder<256> Summary;
+            Summary.Appendf(TEXT("Rate limit suppressed %u messages"), NumSuppressed);
+
+            const FUnlogCallSite* CallSite = State.CallSite.load(std::memory_order_relaxed);
+            if (CallSite && CallSite->Text)
+            {
+                Summary.Append(TEXT(" like \""));
+                Summary.Append(CallSite->Text, FCString::Strlen(CallSite->Text));
+                Summary.AppendChar(TEXT('"'));
+            }
+
+            Target::CallTarget<TargetOptions>(FUnlogMessageSource(), *Category, State.Verbosity.load(std::memory_order_relaxed), FStringView(Summary.ToString(), Summary.Len()));
+            bReported = true;
+        });
+        return bReported;
+    }
+
+private:
+    TUnlogRateLimitReporter()
+        : LastReportSeconds(FPlatformTime::Seconds())
+    {
+        Register(this);
+        FUnlogGameThread::Run([this]
+        {
+            FCoreDelegates::OnEndFrame.AddRaw(this, &TUnlogRateLimitReporter::ReportPeriodically);
+        });
+    }
+
+    void ReportPeriodically()
+    {
+        const double Now = FPlatformTime::Seconds();
+        if (Now - LastReportSeconds >= 1.0)
+        {
+            LastReportSeconds = Now;
+            Flush();
+        }
+    }
+
+    // Only used from the end of frame
+    double LastReportSeconds;
+};
+
+struct FUnlogSamplingState
+{
+    std::atomic<uint32> NumCalls;
+
+    FUnlogSamplingState()
+        : NumCalls(0)
+    {}
+};
+
+// Cheap per thread pseudo random numbers (xorshift64*), good enough for sampling but nothing else
+struct FUnlogRandom
+{
+    static FORCEINLINE uint32 Next()
+    {
+        // Seeded with the thread id so threads starting together don't share their sequence
+        static thread_local uint64 State = 0x9E3779B97F4A7C15ull * (FPlatformTLS::GetCurrentThreadId() + 1) ^ FPlatformTime::Cycles64();
+
+        State ^= State >> 12;
+        State ^= State << 25;
+        State ^= State >> 27;
+        return (uint32)((State * 0x2545F4914F6CDD1Dull) >> 32);
+    }
+};
+#endif // UNLOG_ENABLED
+
+// How a sampled logger picks which calls go through
+enum class EUnlogSampling : uint8
+{
+    // Exactly one every N calls of each call site, starting with the first one
+    EveryNth,
+    // Each call has a 1 in N chance, without any shared state between threads
+    Random
+};
+
+namespace Filter
+{
+    // Lets every call through
+    struct None
+    {
+        template< typename TargetOptions >
+        FORCEINLINE static bool ShouldLog(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity)
+        {
+            return true;
         }
     };
 
     /**
-    * Output messages to the in-game viewport.
-    * Both TimeOnScreen and Color are statically configurable
+    * Combines multiple filters together, calls go through only if every filter lets them.
+    * Filters are run in order and stop at the first one rejecting the call.
     */
-    template< int TimeOnScreen, const FColor& InColor >
-    struct TViewport
+    template< typename... Filters >
+    struct TMultiFilter
     {
-        static void Call(const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FString& Message)
+        template< typename TargetOptions >
+        FORCEINLINE static bool ShouldLog(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity)
         {
-            GEngine->AddOnScreenDebugMessage(INDEX_NONE, TimeOnScreen, InColor, Message);
+            bool bShouldLog = true;
+            int Ignore[] = { 0, (bShouldLog = bShouldLog && Filters::template ShouldLog<TargetOptions>(Source, Category, Verbosity), 0)... };
+            (void)Ignore;
+            return bShouldLog;
         }
     };
 
-    // Default viewport configuration - outputs the message on-screen for 3 seconds and colored in Cyan
-    using Viewport = TViewport<3, FColor::Cyan>;
+    /**
+    * Lets each call site through at most MessagesPerSecond times per second, with bursts of up to Burst calls.
+    * Rejected calls are counted and reported in a single line right before the next call let through,
+    * or by TUnlogRateLimitReporter when none does. Usually created through TUnlog::WithRateLimit.
+    */
+    template< int32 MessagesPerSecond, int32 Burst = MessagesPerSecond >
+    struct TRateLimit
+    {
+        static_assert(MessagesPerSecond > 0 && Burst > 0, "Rate limits need to let at least one message through");
 
-    using Default = UELog;
+#if UNLOG_ENABLED
+        template< typename TargetOptions >
+        static bool ShouldLog(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity)
+        {
+            // The reporter is created along with the first call site's state, keeping it off the suppressed path
+            using FReporter = TUnlogRateLimitReporter<TargetOptions, TRateLimit>;
+            FUnlogRateLimitState* State = FReporter::FStateTable::Get().FindOrAdd(Source.FormatKey, [] { FReporter::Get(); });
+            if (!State)
+            {
+                return true;
+            }
+
+            static const uint64 IntervalCycles = FMath::Max<uint64>(1, (uint64)(1.0 / (FPlatformTime::GetSecondsPerCycle64() * MessagesPerSecond)));
+            const uint64 Now = FPlatformTime::Cycles64();
+            const uint64 Tolerance = IntervalCycles * (Burst - 1);
+
+            uint64 FullAt = State->FullAtCycles.load(std::memory_order_relaxed);
+            do
+            {
+                if (FullAt > Now + Tolerance)
+                {
+                    State->Suppress(Source, Category, Verbosity);
+                    return false;
+                }
+            } while (!State->FullAtCycles.compare_exchange_weak(FullAt, FMath::Max(FullAt, Now) + IntervalCycles, std::memory_order_relaxed));
+
+            if (State->NumSuppressed.load(std::memory_order_relaxed) > 0)
+            {
+                const uint32 NumSuppressed = State->NumSuppressed.exchange(0, std::memory_order_relaxed);
+
+                TStringBuilder<128> Summary;
+                Summary.Appendf(TEXT("Rate limit suppressed %u messages like the following one"), NumSuppressed);
+                Target::CallTarget<TargetOptions>(FUnlogMessageSource(), Category, Verbosity, FStringView(Summary.ToString(), Summary.Len()));
+            }
+
+            return true;
+        }
+#endif // UNLOG_ENABLED
+    };
+
+    /**
+    * Only lets through a sample of 1 in N calls, see EUnlogSampling.
+    * Usually created through TUnlog::WithSampling.
+    */
+    template< uint32 N, EUnlogSampling Sampling = EUnlogSampling::EveryNth >
+    struct TSampling
+    {
+        static_assert(N > 0, "Sampling needs to let at least one in N calls through");
+
+#if UNLOG_ENABLED
+        template< typename TargetOptions >
+        FORCEINLINE static bool ShouldLog(const FUnlogMessageSource& Source, const UnlogCategoryBase& Category, ELogVerbosity::Type Verbosity)
+        {
+            if (Sampling == EUnlogSampling::Random)
+            {
+                // Maps the random number into [0, N) without a division
+                return (((uint64)FUnlogRandom::Next() * N) >> 32) == 0;
+            }
+
+            FUnlogSamplingState* State = TUnlogCallSiteTable<FUnlogSamplingState, TSampling>::Get().FindOrAdd(Source.FormatKey);
+            return !State || State->NumCalls.fetch_add(1, std::memory_order_relaxed) % N == 0;
+        }
+#endif // UNLOG_ENABLED
+    };
 }
 
 // ------------------------------------------------------------------------------------
@@ -679,41 +3944,91 @@ struct TDeriveCategory
 // Simple configuration:
 // using MyLogger = TUnlog<>;
 // ------------------------------------------------------------------------------------
-template<typename InTargetOptions = Target::Default, typename InCategoryPicker = TDeriveCategory<> >
+template<typename InTargetOptions = Target::Default, typename InCategoryPicker = TDeriveCategory<>, ELogVerbosity::Type InCompileTimeVerbosity = ELogVerbosity::All, typename InFilterOptions = Filter::None >
 struct TUnlog
 {
     using CategoryPicker = InCategoryPicker;
     using TargetOptions = InTargetOptions;
+    using FilterOptions = InFilterOptions;
+    static constexpr ELogVerbosity::Type CompileTimeVerbosity = InCompileTimeVerbosity;
 
     /**
     * Specify which targets to output the messages to overriding any previous configuration.
     * Can use multiple targets.
     */
     template< typename... Targets >
-    using WithTargets = TUnlog< Target::TMultiTarget<Targets...>, InCategoryPicker >;
+    using WithTargets = TUnlog< Target::TMultiTarget<Targets...>, InCategoryPicker, InCompileTimeVerbosity, InFilterOptions >;
 
     // Similar to WithTargets but cumulative to whatever configuration it had before. 
     template< typename... Targets >
-    using AddTarget = TUnlog< Target::TMultiTarget<InTargetOptions, Targets...>, InCategoryPicker >;
+    using AddTarget = TUnlog< Target::TMultiTarget<InTargetOptions, Targets...>, InCategoryPicker, InCompileTimeVerbosity, InFilterOptions >;
 
     /**
     * Specify the default category this logger should use without removing the ability 
     * to derive the category if needed.
     */ 
     template< typename InCategory >
-    using WithDefaultCategory = TUnlog< InTargetOptions, TDeriveCategory<InCategory> >;
+    using WithDefaultCategory = TUnlog< InTargetOptions, TDeriveCategory<InCategory>, InCompileTimeVerbosity, InFilterOptions >;
 
     // Sets a specific category and removes any ability to infer the category
     template< typename InCategory >
-    using WithCategory = TUnlog< InTargetOptions, TSpecificCategory<InCategory> >;
+    using WithCategory = TUnlog< InTargetOptions, TSpecificCategory<InCategory>, InCompileTimeVerbosity, InFilterOptions >;
+
+    /**
+    * Runs the targets configured so far on a worker thread so logging doesn't wait on them.
+    * Should come after WithTargets/AddTarget as those would replace or bypass it.
+    */
+    template< EUnlogAsyncPolicy Policy = EUnlogAsyncPolicy::Block, int32 QueueCapacity = UNLOG_ASYNC_QUEUE_CAPACITY >
+    using WithAsync = TUnlog< Target::TAsync<InTargetOptions, Policy, QueueCapacity>, InCategoryPicker, InCompileTimeVerbosity, InFilterOptions >;
+
+    /**
+    * Collapses consecutive repeats of a message, per category, into the first one and a "repeated N times" line.
+    * Reported when a different message comes in or once TimeoutSeconds went by. Like WithAsync it wraps the
+    * targets configured so far, so it should come after WithTargets/AddTarget.
+    */
+    template< int32 TimeoutSeconds = UNLOG_DEDUPLICATION_TIMEOUT >
+    using WithDeduplication = TUnlog< Target::TDeduplicate<InTargetOptions, TimeoutSeconds>, InCategoryPicker, InCompileTimeVerbosity, InFilterOptions >;
+
+    /**
+    * Removes every logging call more verbose than InVerbosity from this logger at compile time,
+    * including the evaluation of their arguments when using the macros.
+    * e.g: TUnlog<>::WithCompileTimeVerbosity< ELogVerbosity::Warning > only keeps Warn and Error.
+    */
+    template< ELogVerbosity::Type InVerbosity >
+    using WithCompileTimeVerbosity = TUnlog< InTargetOptions, InCategoryPicker, InVerbosity, InFilterOptions >;
+
+    /**
+    * Lets each call site log at most MessagesPerSecond times per second (bursts of up to Burst) to survive
+    * log storms. Suppressed calls aren't formatted, their count is reported before the next message let through
+    * or within a second otherwise.
+    * e.g: TUnlog<>::WithRateLimit< 10 >::Warn( "Can't reach {0}", Address );
+    */
+    template< int32 MessagesPerSecond, int32 Burst = MessagesPerSecond >
+    using WithRateLimit = TUnlog< InTargetOptions, InCategoryPicker, InCompileTimeVerbosity, Filter::TMultiFilter< InFilterOptions, Filter::TRateLimit<MessagesPerSecond, Burst> > >;
+
+    /**
+    * Only logs a sample of 1 in N calls of each call site, skipped calls aren't formatted.
+    * Cheap enough to leave high frequency diagnostics on (e.g Verbose categories in playtests).
+    * e.g: TUnlog<>::WithSampling< 100 >::Verbose( "Spawned {0}", Actor->GetName() );
+    */
+    template< uint32 N, EUnlogSampling Sampling = EUnlogSampling::EveryNth >
+    using WithSampling = TUnlog< InTargetOptions, InCategoryPicker, InCompileTimeVerbosity, Filter::TMultiFilter< InFilterOptions, Filter::TSampling<N, Sampling> > >;
+
+    // Blocks until every message held by async loggers or batching targets has been handed over
+    static void Flush()
+    {
+#if UNLOG_ENABLED
+        FUnlogFlushable::FlushAll();
+#endif // UNLOG_ENABLED
+    }
 
     // Logging functions generation
-    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION(CategoryPicker, TargetOptions, Log, Log)
-    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION(CategoryPicker, TargetOptions, Warn, Warning)
-    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION(CategoryPicker, TargetOptions, Error, Error)
-    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION(CategoryPicker, TargetOptions, Display, Display)
-    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION(CategoryPicker, TargetOptions, Verbose, Verbose)
-    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION(CategoryPicker, TargetOptions, VeryVerbose, VeryVerbose)
+    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION(CategoryPicker, TargetOptions, FilterOptions, CompileTimeVerbosity, Log, Log)
+    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION(CategoryPicker, TargetOptions, FilterOptions, CompileTimeVerbosity, Warn, Warning)
+    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION(CategoryPicker, TargetOptions, FilterOptions, CompileTimeVerbosity, Error, Error)
+    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION(CategoryPicker, TargetOptions, FilterOptions, CompileTimeVerbosity, Display, Display)
+    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION(CategoryPicker, TargetOptions, FilterOptions, CompileTimeVerbosity, Verbose, Verbose)
+    UNLOG_DECLARE_CATEGORY_LOG_FUNCTION(CategoryPicker, TargetOptions, FilterOptions, CompileTimeVerbosity, VeryVerbose, VeryVerbose)
 };
 
 // ------------------------------------------------------------------------------------
@@ -723,23 +4038,25 @@ struct TUnlog
 #if UNLOG_ENABLED
 namespace UnlogMacroHelpers
 {
+    // Whether the logger picked by the macro options keeps messages of InVerbosity
+    template< ELogVerbosity::Type InVerbosity, typename MacroOptions >
+    constexpr bool IsCompiledIn()
+    {
+        return InVerbosity <= MacroOptions::UnlogOptions::CompileTimeVerbosity;
+    }
+
     // Inlined function when using any of the user-facing macro functions
-    template< bool IsPrintfFormat, typename MacroOptions, typename FMT, typename... TArgs>
-    FORCEINLINE void Run(ELogVerbosity::Type InVerbosity, const FMT& Format, TArgs... Args)
+    template <bool IsPrintfFormat, ELogVerbosity::Type InVerbosity, typename MacroOptions, typename FMT, typename... TParms>
+    FORCEINLINE static void Run(const FMT& Format, TParms&&... Args)
     {
         using Configuration = TStaticConfiguration<
             TFormatOptions<IsPrintfFormat>,
             typename MacroOptions::UnlogOptions::CategoryPicker,
-            typename MacroOptions::UnlogOptions::TargetOptions
+            typename MacroOptions::UnlogOptions::TargetOptions,
+            typename MacroOptions::UnlogOptions::FilterOptions
         >;
 
-        Unlogger::Get().UnlogPrivateImpl<Configuration>(Format, InVerbosity, Args...);
-    }
-
-    template <bool IsPrintfFormat, ELogVerbosity::Type InVerbosity, typename MacroOptions, typename FMT, typename... TParms>
-    FORCEINLINE static void Run(const FMT& Format, TParms... Args)
-    {
-        Run<IsPrintfFormat, MacroOptions>(InVerbosity, Format, Args...);
+        TUnlogDispatch< IsCompiledIn<InVerbosity, MacroOptions>() >::template Run<Configuration>(Format, InVerbosity, Forward<TParms>(Args)...);
     }
 
     // Helpers structure to hold the base configuration (usually the class named "Unlog")
@@ -755,11 +4072,11 @@ namespace UnlogMacroHelpers
     struct TMacroArgs;
 
     // Matches when passing a TUnlog type settings
-    template<template <typename, typename> class TUnlogSettings, typename TargetOptions, typename CategoryPicker >
-    struct TMacroArgs< TUnlogSettings< TargetOptions, CategoryPicker> >
+    template< typename TargetOptions, typename CategoryPicker, ELogVerbosity::Type CompileTimeVerbosity, typename FilterOptions >
+    struct TMacroArgs< TUnlog< TargetOptions, CategoryPicker, CompileTimeVerbosity, FilterOptions > >
     {
         template< typename TBaseSettings >
-        using GetSettings = TUnlog< TargetOptions, CategoryPicker>;
+        using GetSettings = TUnlog< TargetOptions, CategoryPicker, CompileTimeVerbosity, FilterOptions >;
     };
 
     // Matches when passing just a category
@@ -767,7 +4084,7 @@ namespace UnlogMacroHelpers
     struct TMacroArgs<TCategory>
     {
         template< typename TBaseSettings >
-        using GetSettings = TUnlog< typename TBaseSettings::TargetOptions, TSpecificCategory<TCategory> >;
+        using GetSettings = TUnlog< typename TBaseSettings::TargetOptions, TSpecificCategory<TCategory>, TBaseSettings::CompileTimeVerbosity, typename TBaseSettings::FilterOptions >;
     };
 
     // Default match, don't override any settings.
@@ -787,16 +4104,43 @@ namespace UnlogMacroHelpers
 #if UNLOG_ENABLED
 
 #define PRIV_EXPAND( A ) A
-#define PRIV_UNLOG_PARAMS( Message, ... ) ( TEXT( Message ), ##__VA_ARGS__ )
+
+// Parses the format at compile time into a static owned by the call site, along with the call site's descriptor
+#define PRIV_UNLOG_STATIC_FORMAT( Format ) \
+    ( []( const ANSICHAR* Function ) \
+    { \
+        static constexpr auto ParsedFormat = UnlogFormat::ParseStatic< UnlogFormat::CountSegments( Format ) >( Format ); \
+        static FUnlogCallSite CallSite( __FILE__, __LINE__, &ParsedFormat ); \
+        return UnlogFormat::MakeSited( CallSite, ParsedFormat, Function ); \
+    }( __FUNCTION__ ) )
+
+// Printf formats are passed as is, along with the call site's descriptor
+#define PRIV_UNLOG_PRINTF_FORMAT( Format ) \
+    ( []( const ANSICHAR* Function ) \
+    { \
+        static constexpr const auto& Literal = Format; \
+        static FUnlogCallSite CallSite( __FILE__, __LINE__, Literal ); \
+        return UnlogFormat::MakeSited( CallSite, Literal, Function ); \
+    }( __FUNCTION__ ) )
+
+// Numbered formats are parsed at compile time, printf formats are passed as is
+#define PRIV_UNLOG_PARAMS_false( Message, ... ) ( PRIV_UNLOG_STATIC_FORMAT( TEXT( Message ) ), ##__VA_ARGS__ )
+#define PRIV_UNLOG_PARAMS_true( Message, ... ) ( PRIV_UNLOG_PRINTF_FORMAT( TEXT( Message ) ), ##__VA_ARGS__ )
 #define PRIV_MACRO_BASED_ON_ARG_NUM( _1, _2, FUNCTION, ... ) FUNCTION
 
+// Skips the whole statement, arguments included, when the verbosity is compiled out of the logger
+#define PRIV_UNLOG_IF_COMPILED_IN( InVerbosity, MacroArgs ) \
+    if( !UnlogMacroHelpers::IsCompiledIn< ELogVerbosity::InVerbosity, UnlogMacroHelpers::TMacroOptions< MacroArgs, Unlog > >() ) {} else
+
 // One parameter matches UNLOG( Verbosity )
 #define PRIV_UNLOG_OneParam( IsPrintfFormat, InVerbosity ) \
-    UnlogMacroHelpers::Run< IsPrintfFormat, ELogVerbosity::InVerbosity,UnlogMacroHelpers::TMacroOptions< UnlogMacroHelpers::TMacroArgs<>, Unlog > > PRIV_UNLOG_PARAMS
+    PRIV_UNLOG_IF_COMPILED_IN( InVerbosity, UnlogMacroHelpers::TMacroArgs<> ) \
+    UnlogMacroHelpers::Run< IsPrintfFormat, ELogVerbosity::InVerbosity,UnlogMacroHelpers::TMacroOptions< UnlogMacroHelpers::TMacroArgs<>, Unlog > > PRIV_UNLOG_PARAMS_##IsPrintfFormat
 
 // Two parameters matches UNLOG( Category, Verbosity ) or UNLOG( Options, Verbosity ) 
 #define PRIV_UNLOG_TwoParams( IsPrintfFormat, OptionsOrCategory, InVerbosity ) \
-    UnlogMacroHelpers::Run< IsPrintfFormat, ELogVerbosity::InVerbosity, UnlogMacroHelpers::TMacroOptions< UnlogMacroHelpers::TMacroArgs< OptionsOrCategory >, Unlog > > PRIV_UNLOG_PARAMS
+    PRIV_UNLOG_IF_COMPILED_IN( InVerbosity, UnlogMacroHelpers::TMacroArgs< OptionsOrCategory > ) \
+    UnlogMacroHelpers::Run< IsPrintfFormat, ELogVerbosity::InVerbosity, UnlogMacroHelpers::TMacroOptions< UnlogMacroHelpers::TMacroArgs< OptionsOrCategory >, Unlog > > PRIV_UNLOG_PARAMS_##IsPrintfFormat
 
 
 #define PRIV_UNLOG_IMPL(IsPrintfFormat, ...) \
@@ -819,10 +4163,10 @@ namespace UnlogMacroHelpers
 * Just like the UNLOG macro, but taking a condition as first argument
 * Condition is not evaluated if logging is disabled by the compiler
 */
-#define UNCLOG(Condition, ...)  if(Condition) UNLOG( __VA_ARGS__ )
+#define UNCLOG(Condition, ...)  if(!(Condition)) {} else UNLOG( __VA_ARGS__ )
 
 // Printf version of the UNCLOG macro
-#define UNCLOGF(Condition, ...) if(Condition) UNLOGF( __VA_ARGS__ )
+#define UNCLOGF(Condition, ...) if(!(Condition)) {} else UNLOGF( __VA_ARGS__ )
 
 #else
 #define UNLOG_PARAMS_EMPTY(...) 
@@ -842,23 +4186,25 @@ namespace UnlogMacroHelpers
 #if UNLOG_ENABLED
 
 #define UN_LOG( InMacroArgs, VerbosityName, Message, ... ) \
-    UnlogMacroHelpers::Run< false, UnlogMacroHelpers::TMacroOptions< UnlogMacroHelpers::TMacroArgs< InMacroArgs >, Unlog > >( ELogVerbosity::VerbosityName, TEXT( Message ), ##__VA_ARGS__);
+    PRIV_UNLOG_IF_COMPILED_IN( VerbosityName, UnlogMacroHelpers::TMacroArgs< InMacroArgs > ) \
+    UnlogMacroHelpers::Run< false, ELogVerbosity::VerbosityName, UnlogMacroHelpers::TMacroOptions< UnlogMacroHelpers::TMacroArgs< InMacroArgs >, Unlog > >( PRIV_UNLOG_STATIC_FORMAT( TEXT( Message ) ), ##__VA_ARGS__);
 
 #define UN_LOGF( InMacroArgs, VerbosityName, Message, ... ) \
-    UnlogMacroHelpers::Run< true, UnlogMacroHelpers::TMacroOptions< UnlogMacroHelpers::TMacroArgs< InMacroArgs >, Unlog > >( ELogVerbosity::VerbosityName, TEXT( Message ), ##__VA_ARGS__);
+    PRIV_UNLOG_IF_COMPILED_IN( VerbosityName, UnlogMacroHelpers::TMacroArgs< InMacroArgs > ) \
+    UnlogMacroHelpers::Run< true, ELogVerbosity::VerbosityName, UnlogMacroHelpers::TMacroOptions< UnlogMacroHelpers::TMacroArgs< InMacroArgs >, Unlog > >( PRIV_UNLOG_PRINTF_FORMAT( TEXT( Message ) ), ##__VA_ARGS__);
 
 #define UN_CLOG( Condition, InMacroArgs, VerbosityName, Message, ... ) \
     { \
         if( Condition ) \
         {\
-            UnlogMacroHelpers::Run< false, UnlogMacroHelpers::TMacroOptions< UnlogMacroHelpers::TMacroArgs< InMacroArgs >, Unlog > >( ELogVerbosity::VerbosityName, TEXT( Message ), ##__VA_ARGS__); \
+            UN_LOG( InMacroArgs, VerbosityName, Message, ##__VA_ARGS__ ) \
         }\
     }
 #define UN_CLOGF( Condition, InMacroArgs, VerbosityName, Message, ... ) \
     {\
         if( Condition ) \
         {\
-            UnlogMacroHelpers::Run< true, UnlogMacroHelpers::TMacroOptions< UnlogMacroHelpers::TMacroArgs< InMacroArgs >, Unlog > >( ELogVerbosity::VerbosityName, TEXT( Message ), ##__VA_ARGS__); \
+            UN_LOGF( InMacroArgs, VerbosityName, Message, ##__VA_ARGS__ ) \
         }\
     }
 #else